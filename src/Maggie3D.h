@@ -4,7 +4,7 @@
  * Maggie3D shared library
  *
  * @author Fabrice Labrador <fabrice.labrador@gmail.com>
- * @version 1.6 June 2024 (updated: 24/06/2024)
+ * @version 1.7 October 2026 (updated: 17/10/2026)
  */
 
 #ifndef _MAGGIE3D_H_
@@ -36,6 +36,7 @@
 #define M3D_NOPALETTE             -14           // No texture palette
 #define M3D_TEXRESIZE             -15           // Texture resize error
 #define M3D_NOQUAD                -16           // Quad is degenerated and not drawable
+#define M3D_BADPARAM              -17           // Bad parameter value
 #define M3D_UNKNOW                -42           // Unknown error
 
 // Maggie mode
@@ -53,12 +54,31 @@
 #define M3D_ZBUFFERUPDATE         (1 << 4)      // Z buffer update
 #define M3D_BLENDING              (1 << 5)      // Color blending
 #define M3D_TEXCRDNORM            (1 << 6)      // Texture coordinates normalized
-#define M3D_FAST                  (1 << 7)      // Modify triangle data
+#define M3D_FAST                  (1 << 7)      // No effect, figures are never modified
 #define M3D_PERSPECTIVE           (1 << 8)      // Perspective correction
+#define M3D_SPANQUEUE             (1 << 9)      // Queue the spans and feed Maggie in batch
+#define M3D_BINNING               (1 << 10)     // Bin the spans in screen tiles until the hardware is unlocked
+#define M3D_DIRTYCLEAR            (1 << 11)     // Clear only the screen tiles drawn since the last clear
+#define M3D_STATESORT             (1 << 12)     // Group the opaque scene figures by states, texture & color
+#define M3D_FRUSTUMCLIP           (1 << 13)     // Vertices are in homogeneous clip space, clip them against the frustum
+#define M3D_CULLBACK              (1 << 14)     // Reject the figures with counter clockwise vertices on screen
+#define M3D_CULLFRONT             (1 << 15)     // Reject the figures with clockwise vertices on screen
 
 #define M3D_DISABLE               0             // Disable the state
 #define M3D_ENABLE                1             // Enable the state
 
+// Perspective correction span length
+#define M3D_PERSP8                8             // Correct texture every 8 pixels
+#define M3D_PERSP16               16            // Correct texture every 16 pixels (default)
+#define M3D_PERSP32               32            // Correct texture every 32 pixels
+
+// Maximum number of frames sharing one Z buffer clear
+#define M3D_MAXZFRAMES            16
+
+// Index format
+#define M3D_INDEX16               0             // Indices are UWORD
+#define M3D_INDEX32               1             // Indices are ULONG
+
 // Maggie texture size
 #define M3D_TEX64                 6             // Texture 64x64
 #define M3D_TEX128                7             // Texture 128x128
@@ -105,6 +125,8 @@ typedef struct {
   APTR data;
   ULONG width, height;
   UWORD mipsize, filtering;
+  BOOL transparency;
+  FLOAT scale;
 } M3D_Texture;
 
 // Maggie3D triangle
@@ -131,6 +153,11 @@ typedef struct {
   ULONG color;
 } M3D_Sprite;
 
+// Maggie3D sprite position
+typedef struct {
+  LONG x, y;
+} M3D_Position;
+
 // Maggie3D clipping scissor
 typedef struct {
   ULONG left, top, width, height;
@@ -160,6 +187,23 @@ typedef struct {
   ULONG *flat_shading;
   BOOL maggie_available;
   M3D_Texture *textures[M3D_MAX_TEXTURE];
+  UWORD persp_span;
+  APTR vertex_buffer;
+  ULONG vertex_buffer_size;
+  APTR prim_buffer;
+  ULONG prim_buffer_size, prim_count;
+  APTR bin_buffer;
+  ULONG bin_buffer_size, bin_count;
+  APTR hiz_data;
+  ULONG hiz_width, hiz_height;
+  UWORD zbuffer_frames, zbuffer_frame;
+  FLOAT z_scale, z_offset;
+  APTR dirty_data;
+  ULONG dirty_width, dirty_height;
+  APTR sort_buffer;
+  ULONG sort_buffer_size;
+  BOOL scene;
+  APTR shaded_kernels, textured_kernels;
 } M3D_Context;
 
 #endif
@@ -18,6 +18,7 @@ M3D_Context *M3D_CreateContext(LONG *, struct BitMap *);
 VOID M3D_DestroyContext(M3D_Context *);
 LONG M3D_SetState(M3D_Context *, UWORD, BOOL);
 BOOL M3D_GetState(M3D_Context *, UWORD);
+LONG M3D_SetPerspectiveSpan(M3D_Context *, UWORD);
 
 /************************** Hardware/Driver functions ***************************/
 BOOL M3D_CheckMaggie(VOID);
@@ -37,8 +38,16 @@ VOID M3D_FreeAllTextures(M3D_Context *);
 LONG M3D_DrawTriangle(M3D_Context *, M3D_Triangle *);
 LONG M3D_DrawTriangleArray(M3D_Context *, M3D_Triangle *, ULONG);
 LONG M3D_DrawTriangleList(M3D_Context *, M3D_Triangle **, ULONG);
+LONG M3D_DrawIndexedTriangles(M3D_Context *, M3D_Vertex *, APTR, ULONG, M3D_Texture *, UWORD, ULONG);
+LONG M3D_DrawTriangleStrip(M3D_Context *, M3D_Vertex *, ULONG, M3D_Texture *, ULONG);
+LONG M3D_DrawTriangleFan(M3D_Context *, M3D_Vertex *, ULONG, M3D_Texture *, ULONG);
 LONG M3D_DrawQuad(M3D_Context *, M3D_Quad *);
+LONG M3D_DrawQuadArray(M3D_Context *, M3D_Quad *, ULONG);
+LONG M3D_DrawQuadList(M3D_Context *, M3D_Quad **, ULONG);
 LONG M3D_DrawSprite(M3D_Context *, M3D_Sprite *, LONG, LONG);
+LONG M3D_DrawSpriteArray(M3D_Context *, M3D_Sprite *, M3D_Position *, ULONG);
+LONG M3D_BeginScene(M3D_Context *);
+LONG M3D_EndScene(M3D_Context *);
 LONG M3D_ClearDrawRegion(M3D_Context *, ULONG);
 
 /************************** Effect functions ************************************/
@@ -49,5 +58,6 @@ LONG M3D_SetScissor(M3D_Context *, M3D_Scissor *);
 LONG M3D_AllocZBuffer(M3D_Context *);
 VOID M3D_FreeZBuffer(M3D_Context *);
 LONG M3D_ClearZBuffer(M3D_Context *);
+LONG M3D_SetZBufferFrames(M3D_Context *, UWORD);
 
 #endif
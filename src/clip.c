@@ -0,0 +1,175 @@
+/**
+ * clip.c
+ *
+ * Maggie3D shared library
+ * Frustum clipping functions (homogeneous coordinates)
+ *
+ * @author Fabrice Labrador <fabrice.labrador@gmail.com>
+ * @version 1.7 (updated: 17/10/2026)
+ */
+
+#include <stdio.h>
+
+#include <proto/exec.h>
+
+#include "debug.h"
+#include "draw.h"
+#include "zbuffer.h"
+
+#if _ACTIVATE_DEBUG_ == 1
+extern BOOL draw_debug;
+#endif
+
+/*****************************************************************************/
+/**                     FRUSTUM CLIPPING                                     */
+/*****************************************************************************/
+
+/** Frustum clipping codes of a vertex in homogeneous coordinates */
+UBYTE M3D_FrustumCode(M3D_Vertex *vertex)
+{
+  UBYTE code = 0;
+
+  if (vertex->x < -vertex->w) {
+    code |= CLIP_LEFT;
+  } else if (vertex->x > vertex->w) {
+    code |= CLIP_RIGHT;
+  }
+  if (vertex->y > vertex->w) {
+    code |= CLIP_TOP;
+  } else if (vertex->y < -vertex->w) {
+    code |= CLIP_BOTTOM;
+  }
+  if (vertex->z < 0.0) {
+    code |= CLIP_NEAR;
+  } else if (vertex->z > vertex->w) {
+    code |= CLIP_FAR;
+  }
+  return code;
+}
+
+/** Signed distance of a vertex to a frustum plane, positive inside the frustum */
+FLOAT M3D_PlaneDistance(M3D_Vertex *vertex, UBYTE plane)
+{
+  switch (plane) {
+    case CLIP_LEFT:
+      return vertex->w + vertex->x;
+    case CLIP_RIGHT:
+      return vertex->w - vertex->x;
+    case CLIP_TOP:
+      return vertex->w - vertex->y;
+    case CLIP_BOTTOM:
+      return vertex->w + vertex->y;
+    case CLIP_NEAR:
+      return vertex->z;
+  }
+  return vertex->w - vertex->z;
+}
+
+/** Interpolate a new vertex between an inside vertex & an outside vertex */
+VOID M3D_LerpVertex(M3D_Vertex *inside, M3D_Vertex *outside, FLOAT t, M3D_Vertex *vertex)
+{
+  vertex->x = inside->x + (outside->x - inside->x) * t;
+  vertex->y = inside->y + (outside->y - inside->y) * t;
+  vertex->z = inside->z + (outside->z - inside->z) * t;
+  vertex->w = inside->w + (outside->w - inside->w) * t;
+  vertex->u = inside->u + (outside->u - inside->u) * t;
+  vertex->v = inside->v + (outside->v - inside->v) * t;
+  vertex->light = inside->light + (outside->light - inside->light) * t;
+}
+
+/** Clip a polygon against one frustum plane, return the vertex count of the clipped polygon */
+ULONG M3D_ClipPolygon(M3D_Vertex *polygon, ULONG count, M3D_Vertex *clipped, UBYTE plane)
+{
+  M3D_Vertex *previous, *current;
+  FLOAT dprev, dcur;
+  ULONG index, total = 0;
+
+  previous = &(polygon[count - 1]);
+  dprev = M3D_PlaneDistance(previous, plane);
+  for (index = 0;index < count;index++) {
+    current = &(polygon[index]);
+    dcur = M3D_PlaneDistance(current, plane);
+    // The edge crosses the plane, always interpolate from the inside vertex so shared edges give the same vertex
+    if (dprev >= 0.0 && dcur < 0.0) {
+      M3D_LerpVertex(previous, current, dprev / (dprev - dcur), &(clipped[total++]));
+    } else if (dprev < 0.0 && dcur >= 0.0) {
+      M3D_LerpVertex(current, previous, dcur / (dcur - dprev), &(clipped[total++]));
+    }
+    if (dcur >= 0.0) {
+      CopyMem(current, &(clipped[total++]), sizeof(M3D_Vertex));
+    }
+    previous = current;
+    dprev = dcur;
+  }
+  return total;
+}
+
+/** Project a clipped vertex on the clipping scissor, W is kept for the perspective correction */
+VOID M3D_ProjectVertex(M3D_Vertex *vertex, M3D_DrawData *draw_data)
+{
+  FLOAT inv_w;
+
+  inv_w = 1.0 / vertex->w;
+  vertex->x = draw_data->left_clip + (vertex->x * inv_w + 1.0) * 0.5 * (draw_data->right_clip - draw_data->left_clip);
+  vertex->y = draw_data->top_clip + (1.0 - vertex->y * inv_w) * 0.5 * (draw_data->bottom_clip - draw_data->top_clip);
+  vertex->z = vertex->z * inv_w * (ZBUF_RANGE - 1.0);
+}
+
+/** Clip a figure in homogeneous coordinates, then draw the visible polygon as a fan of triangles */
+BOOL M3D_ClipFigure(M3D_Context *context, M3D_Vertex *vertices, ULONG count, M3D_Texture *texture, ULONG color, M3D_DrawData *draw_data)
+{
+  M3D_Vertex polygon[2][M3D_CLIP_VERTICES];
+  M3D_Triangle triangle;
+  UBYTE code, codes_and, codes_or, plane;
+  ULONG index, total, current;
+  WORDBITS states;
+  BOOL drawn;
+
+  codes_and = 0xff;
+  codes_or = 0;
+  for (index = 0;index < count;index++) {
+    code = M3D_FrustumCode(&(vertices[index]));
+    codes_and &= code;
+    codes_or |= code;
+  }
+  // Trivial rejection when all vertices are outside of the same plane
+  if (codes_and) {
+    return FALSE;
+  }
+  CopyMem(vertices, polygon[0], count * sizeof(M3D_Vertex));
+  total = count;
+  current = 0;
+  // Only the planes crossed by the figure are clipped
+  for (plane = CLIP_LEFT;plane <= CLIP_FAR && total >= 3;plane <<= 1) {
+    if (codes_or & plane) {
+      total = M3D_ClipPolygon(polygon[current], total, polygon[current ^ 1], plane);
+      current ^= 1;
+    }
+  }
+  if (total < 3) {
+    return FALSE;
+  }
+  for (index = 0;index < total;index++) {
+    if (polygon[current][index].w <= 0.0) {
+      return FALSE;
+    }
+    M3D_ProjectVertex(&(polygon[current][index]), draw_data);
+  }
+  DDbug(kprintf("[MAGGIE3D] Clipped figure of %ld vertices in %ld triangles\n", count, total - 2);)
+  // The projected triangles go through the normal setup, binning & scene included
+  states = context->states;
+  context->states &= ~M3D_FRUSTUMCLIP;
+  triangle.texture = texture;
+  triangle.color = color;
+  drawn = FALSE;
+  for (index = 2;index < total;index++) {
+    CopyMem(&(polygon[current][0]), &(triangle.v1), sizeof(M3D_Vertex));
+    CopyMem(&(polygon[current][index - 1]), &(triangle.v2), sizeof(M3D_Vertex));
+    CopyMem(&(polygon[current][index]), &(triangle.v3), sizeof(M3D_Vertex));
+    if (M3D_RenderTriangle(context, &triangle, draw_data) != TRI_REJECTED) {
+      drawn = TRUE;
+    }
+  }
+  context->states = states;
+  return drawn;
+}
@@ -99,27 +99,6 @@ VOID FLR_DecodePixels(ULONG pixels, ULONG *colors, ULONG *dst, ULONG width)
   }
 }
 
-VOID FLR_DecompressDXT1(UBYTE *src, UBYTE *dst, ULONG width, ULONG height)
-{
-  ULONG wblock, hblock, pixels, colors[4];
-  UWORD color0, color1;
-  
-  for (hblock = 0;hblock < height;hblock += 4) {
-    for (wblock = 0;wblock < width;wblock += 4) {
-      color0 = (src[1] << 8) | src[0];
-      src += 2;
-      color1 = (src[1] << 8) | src[0];
-      src += 2;
-      pixels = (src[3] << 24) | (src[2] << 16) | (src[1] << 8) | src[0];
-      src += 4;
-      FLR_DecodeColors(colors, color0, color1);
-      FLR_DecodePixels(pixels, colors, (ULONG *)dst, width);
-      dst += 4 * 4;
-    }
-    dst += width * 4 * 3;
-  }
-}
-
 /**
  * DXT1 compression functions
  */
@@ -373,13 +352,38 @@ LONG M3D_ConvertToDXT1(M3D_Texture *texture, APTR data, ULONG data_size)
   return M3D_SUCCESS;
 }
 
-/** Convert DXT1 to RAW RGBA texture */
-LONG M3D_ConvertFromDXT1(M3D_Texture *texture, APTR data)
+/** Check if a RGBA texture has transparent texels */
+BOOL M3D_CheckRGBATransparency(UBYTE *data, ULONG size)
 {
-  UBYTE *dst;
-  
-  Dbug(kprintf("[MAGGIE3D] Convert texture data to RGBA format\n");)
-  dst = (UBYTE *)texture->data;
-  FLR_DecompressDXT1(data, dst, texture->width, texture->height);
-  return M3D_SUCCESS;
+  data += 3;
+  while (size--) {
+    if (*data < 0x80) {
+      return TRUE;
+    }
+    data += 4;
+  }
+  return FALSE;
+}
+
+/** Check if DXT1 blocks have transparent texels */
+BOOL M3D_CheckDXT1Transparency(UBYTE *data, ULONG size)
+{
+  ULONG pixels, index;
+  UWORD color0, color1;
+
+  while (size--) {
+    color0 = (data[1] << 8) | data[0];
+    color1 = (data[3] << 8) | data[2];
+    pixels = (data[7] << 24) | (data[6] << 16) | (data[5] << 8) | data[4];
+    // Only blocks with color0 <= color1 have a transparent color index
+    if (color0 <= color1) {
+      for (index = 0;index < 16;index++) {
+        if (((pixels >> (index * 2)) & 0x3) == 0x3) {
+          return TRUE;
+        }
+      }
+    }
+    data += 8;
+  }
+  return FALSE;
 }
@@ -23,6 +23,11 @@
 #define _USE_MAGGIE_          1
 #endif
 
+// Use 16:16 fixed point edge walker in span functions (or FLOAT walker, always used beyond the fixed point range)
+#ifndef _USE_FIXEDEDGE_
+#define _USE_FIXEDEDGE_       1
+#endif
+
 // Use fast ASM functions (not really stable)
 #ifndef _USE_FASTASM_
 #define _USE_FASTASM_         0
@@ -19,7 +19,10 @@
 #include <proto/cybergraphics.h>
 
 #include "debug.h"
+#include "memory.h"
 #include "draw.h"
+#include "texture.h"
+#include "zbuffer.h"
 
 #if _USE_MAGGIE_ == 1
 M3D_MaggieRegs *maggie = (M3D_MaggieRegs *) M3D_MAGGIEBASE;
@@ -28,6 +31,13 @@ M3D_MaggieRegs reg_maggie;
 M3D_MaggieRegs *maggie = &reg_maggie;
 #endif
 
+// Last values written to the Maggie registers which do not change on every span
+M3D_MaggieRegs maggie_shadow;
+
+// Spans waiting to be fed to Maggie
+M3D_SpanCmd span_queue[M3D_SPANQUEUE_SIZE];
+UWORD span_count = 0;
+
 /*****************************************************************************/
 //            DEBUG ONLY
 /*****************************************************************************/
@@ -46,31 +56,31 @@ VOID M3D_DrawDebug(BOOL flag)
 #define UFIXEDTOFLOAT(x)      ((FLOAT)(x) / 65535.0)
 #define LFIXEDTOFLOAT(x)      ((FLOAT)(x) / 65536.0)
 
-VOID M3D_DumpTriangle(M3D_Triangle *triangle)
+VOID M3D_DumpTriangle(M3D_OrderedTriangle *triangle)
 {
   kprintf("[MAGGIE3D] Dump triangle\n");
   /*printf("[MAGGIE3D] => x1=%f  y1=%f  z1=%f  u1=%f  v1=%f  light=%f\n",
-      triangle->v1.x, triangle->v1.y, triangle->v1.z, triangle->v1.u, triangle->v1.v, triangle->v1.light);
+      triangle->v1->x, triangle->v1->y, triangle->v1->z, triangle->v1->vertex->u, triangle->v1->vertex->v, triangle->v1->vertex->light);
   printf("[MAGGIE3D] => x2=%f  y2=%f  z2=%f  u2=%f  v2=%f  light=%f\n",
-      triangle->v2.x, triangle->v2.y, triangle->v2.z, triangle->v2.u, triangle->v2.v, triangle->v2.light);
+      triangle->v2->x, triangle->v2->y, triangle->v2->z, triangle->v2->vertex->u, triangle->v2->vertex->v, triangle->v2->vertex->light);
   printf("[MAGGIE3D] => x3=%f  y3=%f  z3=%f  u3=%f  v3=%f  light=%f\n",
-      triangle->v3.x, triangle->v3.y, triangle->v3.z, triangle->v3.u, triangle->v3.v, triangle->v3.light);
+      triangle->v3->x, triangle->v3->y, triangle->v3->z, triangle->v3->vertex->u, triangle->v3->vertex->v, triangle->v3->vertex->light);
   printf("[MAGGIE3D] => texw=%d  texh=%d  texs=%d  texdata=0x%X  color=0x%X\n",
       triangle->texture->width, triangle->texture->height, triangle->texture->mipsize, triangle->texture->data, triangle->color);*/
   kprintf("[MAGGIE3D] !!! NOT AVAILABLE !!!\n");
 }
 
-VOID M3D_DumpQuad(M3D_Quad *quad)
+VOID M3D_DumpQuad(M3D_OrderedQuad *quad)
 {
   kprintf("[MAGGIE3D] Dump quad\n");
   /*printf("[MAGGIE3D] => x1=%f  y1=%f  z1=%f  u1=%f  v1=%f  light=%f\n",
-      quad->v1.x, quad->v1.y, quad->v1.z, quad->v1.u, quad->v1.v, quad->v1.light);
+      quad->v1->x, quad->v1->y, quad->v1->z, quad->v1->vertex->u, quad->v1->vertex->v, quad->v1->vertex->light);
   printf("[MAGGIE3D] => x2=%f  y2=%f  z2=%f  u2=%f  v2=%f  light=%f\n",
-      quad->v2.x, quad->v2.y, quad->v2.z, quad->v2.u, quad->v2.v, quad->v2.light);
+      quad->v2->x, quad->v2->y, quad->v2->z, quad->v2->vertex->u, quad->v2->vertex->v, quad->v2->vertex->light);
   printf("[MAGGIE3D] => x3=%f  y3=%f  z3=%f  u3=%f  v3=%f  light=%f\n",
-      quad->v3.x, quad->v3.y, quad->v3.z, quad->v3.u, quad->v3.v, quad->v3.light);
+      quad->v3->x, quad->v3->y, quad->v3->z, quad->v3->vertex->u, quad->v3->vertex->v, quad->v3->vertex->light);
   printf("[MAGGIE3D] => x4=%f  y4=%f  z4=%f  u4=%f  v4=%f  light=%f\n",
-      quad->v4.x, quad->v4.y, quad->v4.z, quad->v4.u, quad->v4.v, quad->v4.light);
+      quad->v4->x, quad->v4->y, quad->v4->z, quad->v4->vertex->u, quad->v4->vertex->v, quad->v4->vertex->light);
   printf("[MAGGIE3D] => texw=%d  texh=%d  texs=%d  texdata=0x%X  color=0x%X\n",
       quad->texture->width, quad->texture->height, quad->texture->mipsize, quad->texture->data, quad->color);*/
   kprintf("[MAGGIE3D] !!! NOT AVAILABLE !!!\n");
@@ -132,176 +142,356 @@ VOID M3D_DumpMaggieRegs(VOID)
 /*****************************************************************************/
 
 #if _USE_MAGGIE_ == 0
-/** Output 16bits texel */
-VOID M3D_Maggie16Bits(UWORD *dest, ULONG texel)
-{
-  *dest = (UWORD) (((texel & 0xf80000) >> 8) | ((texel & 0xfc00) >> 5) | ((texel & 0xf8) >> 3));
-}
+// Exact division by 0xff of a product of two bytes
+#define M3D_DIV255(x)         (((x) + 1 + ((x) >> 8)) >> 8)
 
-/** Output 24bits texel */
-VOID M3D_Maggie24Bits(UBYTE *dest, ULONG texel)
-{
-  *dest++ = (UBYTE) ((texel >> 16) & 0xff);
-  *dest++ = (UBYTE) ((texel >> 8) & 0xff);
-  *dest = (UBYTE) (texel & 0xff);
-}
+// Exact division by 0xff of the red & blue products packed in the two halves of a long
+#define M3D_DIV255RB(x)       ((((x) + (((x) >> 8) & 0x00ff00ff) + 0x00010001) >> 8) & 0x00ff00ff)
 
-/** Output 32bits texel */
-VOID M3D_Maggie32Bits(ULONG *dest, ULONG texel)
+// Decoded DXT1 blocks, a window of 8 x 8 blocks of the texture
+M3D_DecodedBlock block_cache[M3D_BLOCK_CACHE];
+
+/** Forget the decoded blocks, their texture may be released */
+VOID M3D_FlushBlockCache(VOID)
 {
-  *dest = texel;
+  ULONG index;
+
+  for (index = 0;index < M3D_BLOCK_CACHE;index++) {
+    block_cache[index].block = NULL;
+  }
 }
 
-/** Apply color blend */
-ULONG M3D_MaggieBlend(ULONG texel, UBYTE red, UBYTE green, UBYTE blue)
+/** Texel of the DXT1 texture at a texture column & row, the block is decoded only once */
+ULONG M3D_EmulateDXT1(M3D_EmulatedSpan *span, ULONG x, ULONG y)
 {
-  ULONG tr, tg, tb;
+  M3D_DecodedBlock *cached;
+  UBYTE *block;
+  ULONG colors[4];
 
-  tr = (texel >> 16) & 0xff;
-  tg = (texel >> 8) & 0xff;
-  tb = texel & 0xff;
-  tr = tr * red / 0xff;
-  tg = tg * green / 0xff;
-  tb = tb * blue / 0xff;
-  return ((tr << 16) | (tg << 8) | tb);
+  block = span->texture + ((((y >> 2) << span->block_shift) + (x >> 2)) << 3);
+  cached = &block_cache[((y << 1) & 0x38) | ((x >> 2) & 0x7)];
+  if (cached->block != block) {
+    FLR_DecodeColors(colors, (UWORD) ((block[1] << 8) | block[0]), (UWORD) ((block[3] << 8) | block[2]));
+    FLR_DecodePixels(((ULONG) block[7] << 24) | (block[6] << 16) | (block[5] << 8) | block[4], colors, cached->texels, 4);
+    cached->block = block;
+  }
+  return cached->texels[((y & 0x3) << 2) | (x & 0x3)];
 }
 
-/** Apply color shade */
-ULONG M3D_MaggieShade(ULONG texel, UBYTE shade)
+/** Bilinear filtered texel, the four texels are blended two channels at a time with 8bits weights */
+ULONG M3D_EmulateBilinear(M3D_EmulatedSpan *span, LFIXED ui, LFIXED vi)
 {
-  ULONG tr, tg, tb;
+  ULONG u, v, fu, fv, x0, x1, y0, y1, t0, t1, t2, t3, rb0, rb1, ga0, ga1;
 
-  tr = (texel >> 16) & 0xff;
-  tg = (texel >> 8) & 0xff;
-  tb = texel & 0xff;
-  tr = tr * shade / 0xff;
-  tg = tg * shade / 0xff;
-  tb = tb * shade / 0xff;
-  return ((tr << 16) | (tg << 8) | tb);
+  u = ((ULONG) ui) >> span->filter_scale;
+  v = ((ULONG) vi) >> span->filter_scale;
+  fu = u & 0xff;
+  fv = v & 0xff;
+  // The neighbour texels wrap on the texture size
+  x0 = (u >> 8) & span->tex_mask;
+  x1 = ((u >> 8) + 1) & span->tex_mask;
+  y0 = (v >> 8) & span->tex_mask;
+  y1 = ((v >> 8) + 1) & span->tex_mask;
+  t0 = M3D_EmulateDXT1(span, x0, y0);
+  t1 = M3D_EmulateDXT1(span, x1, y0);
+  t2 = M3D_EmulateDXT1(span, x0, y1);
+  t3 = M3D_EmulateDXT1(span, x1, y1);
+  // Horizontal blend of both rows, red & blue then green & alpha
+  rb0 = ((((t0 >> 8) & 0x00ff00ff) * (256 - fu) + ((t1 >> 8) & 0x00ff00ff) * fu) >> 8) & 0x00ff00ff;
+  rb1 = ((((t2 >> 8) & 0x00ff00ff) * (256 - fu) + ((t3 >> 8) & 0x00ff00ff) * fu) >> 8) & 0x00ff00ff;
+  ga0 = (((t0 & 0x00ff00ff) * (256 - fu) + (t1 & 0x00ff00ff) * fu) >> 8) & 0x00ff00ff;
+  ga1 = (((t2 & 0x00ff00ff) * (256 - fu) + (t3 & 0x00ff00ff) * fu) >> 8) & 0x00ff00ff;
+  // Vertical blend of the rows
+  rb0 = ((rb0 * (256 - fv) + rb1 * fv) >> 8) & 0x00ff00ff;
+  ga0 = ((ga0 * (256 - fv) + ga1 * fv) >> 8) & 0x00ff00ff;
+  return (rb0 << 8) | ga0;
 }
 
-/** Simple emulation of Maggie feature, assume texture is RGB */
+/**
+ * Body of an emulated span kernel, the mode parameters are constants so each kernel
+ * only keeps the steps of its mode and nothing is tested per texel
+ */
+#define M3D_EMULATE_KERNEL(name, textured, filtered, zbuffered, blended, depth) \
+VOID name(M3D_EmulatedSpan *span) \
+{ \
+  UBYTE *destination = span->destination; \
+  UWORD *zbuffer = span->zbuffer; \
+  LFIXED ui = span->u_start, vi = span->v_start, zi = span->z_start; \
+  UFIXED li = span->light_start; \
+  ULONG texel, rb, g, shade; \
+  UWORD count = span->count; \
+  \
+  while (count--) { \
+    if (textured && (filtered)) { \
+      texel = M3D_EmulateBilinear(span, ui, vi); \
+    } else if (textured) { \
+      texel = M3D_EmulateDXT1(span, (((ULONG) ui) >> span->tex_scale) & span->tex_mask, (((ULONG) vi) >> span->tex_scale) & span->tex_mask); \
+    } else { \
+      texel = 0xffffffff; \
+    } \
+    if ((texel & 0xff) >= 0x80 && (!(zbuffered) || (zi >> 16) <= *zbuffer)) { \
+      if (zbuffered) { \
+        *zbuffer = (UWORD) (zi >> 16); \
+      } \
+      if (textured) { \
+        texel >>= 8; \
+        if (blended) { \
+          texel = (M3D_DIV255((texel >> 16) * span->red) << 16) \
+                | (M3D_DIV255(((texel >> 8) & 0xff) * span->green) << 8) \
+                | M3D_DIV255((texel & 0xff) * span->blue); \
+        } \
+      } else { \
+        texel = span->color; \
+      } \
+      /* Red & blue are shaded together, each one in a half of the long */ \
+      shade = li >> 8; \
+      rb = (texel & 0x00ff00ff) * shade; \
+      rb = M3D_DIV255RB(rb); \
+      g = ((texel >> 8) & 0xff) * shade; \
+      g = M3D_DIV255(g); \
+      if ((depth) == 16) { \
+        *((UWORD *) destination) = (UWORD) (((rb >> 8) & 0xf800) | ((g & 0xfc) << 3) | ((rb & 0xf8) >> 3)); \
+      } else if ((depth) == 24) { \
+        destination[0] = (UBYTE) (rb >> 16); \
+        destination[1] = (UBYTE) g; \
+        destination[2] = (UBYTE) rb; \
+      } else { \
+        *((ULONG *) destination) = rb | (g << 8); \
+      } \
+    } \
+    destination += span->modulo; \
+    zbuffer++; \
+    ui += span->u_delta; \
+    vi += span->v_delta; \
+    zi += span->z_delta; \
+    li += span->light_delta; \
+  } \
+}
+
+// 16bits output kernels
+M3D_EMULATE_KERNEL(M3D_EmulateShaded16, FALSE, FALSE, FALSE, FALSE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateTextured16, TRUE, FALSE, FALSE, FALSE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedBlend16, TRUE, FALSE, FALSE, TRUE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateFiltered16, TRUE, TRUE, FALSE, FALSE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredBlend16, TRUE, TRUE, FALSE, TRUE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateShadedZ16, FALSE, FALSE, TRUE, FALSE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedZ16, TRUE, FALSE, TRUE, FALSE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedBlendZ16, TRUE, FALSE, TRUE, TRUE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredZ16, TRUE, TRUE, TRUE, FALSE, 16)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredBlendZ16, TRUE, TRUE, TRUE, TRUE, 16)
+
+// 24bits output kernels
+M3D_EMULATE_KERNEL(M3D_EmulateShaded24, FALSE, FALSE, FALSE, FALSE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateTextured24, TRUE, FALSE, FALSE, FALSE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedBlend24, TRUE, FALSE, FALSE, TRUE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateFiltered24, TRUE, TRUE, FALSE, FALSE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredBlend24, TRUE, TRUE, FALSE, TRUE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateShadedZ24, FALSE, FALSE, TRUE, FALSE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedZ24, TRUE, FALSE, TRUE, FALSE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedBlendZ24, TRUE, FALSE, TRUE, TRUE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredZ24, TRUE, TRUE, TRUE, FALSE, 24)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredBlendZ24, TRUE, TRUE, TRUE, TRUE, 24)
+
+// 32bits output kernels
+M3D_EMULATE_KERNEL(M3D_EmulateShaded32, FALSE, FALSE, FALSE, FALSE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateTextured32, TRUE, FALSE, FALSE, FALSE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedBlend32, TRUE, FALSE, FALSE, TRUE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateFiltered32, TRUE, TRUE, FALSE, FALSE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredBlend32, TRUE, TRUE, FALSE, TRUE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateShadedZ32, FALSE, FALSE, TRUE, FALSE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedZ32, TRUE, FALSE, TRUE, FALSE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateTexturedBlendZ32, TRUE, FALSE, TRUE, TRUE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredZ32, TRUE, TRUE, TRUE, FALSE, 32)
+M3D_EMULATE_KERNEL(M3D_EmulateFilteredBlendZ32, TRUE, TRUE, TRUE, TRUE, 32)
+
+// Emulated span kernels indexed by the output depth, then by (zbuffer << 3 | filter << 2 | textured << 1 | blend),
+// the color of a shaded span is blended once for the whole span
+M3D_EmulateKernel emulate_table[3][16] = {
+  {
+    M3D_EmulateShaded16, M3D_EmulateShaded16, M3D_EmulateTextured16, M3D_EmulateTexturedBlend16,
+    M3D_EmulateShaded16, M3D_EmulateShaded16, M3D_EmulateFiltered16, M3D_EmulateFilteredBlend16,
+    M3D_EmulateShadedZ16, M3D_EmulateShadedZ16, M3D_EmulateTexturedZ16, M3D_EmulateTexturedBlendZ16,
+    M3D_EmulateShadedZ16, M3D_EmulateShadedZ16, M3D_EmulateFilteredZ16, M3D_EmulateFilteredBlendZ16
+  },
+  {
+    M3D_EmulateShaded24, M3D_EmulateShaded24, M3D_EmulateTextured24, M3D_EmulateTexturedBlend24,
+    M3D_EmulateShaded24, M3D_EmulateShaded24, M3D_EmulateFiltered24, M3D_EmulateFilteredBlend24,
+    M3D_EmulateShadedZ24, M3D_EmulateShadedZ24, M3D_EmulateTexturedZ24, M3D_EmulateTexturedBlendZ24,
+    M3D_EmulateShadedZ24, M3D_EmulateShadedZ24, M3D_EmulateFilteredZ24, M3D_EmulateFilteredBlendZ24
+  },
+  {
+    M3D_EmulateShaded32, M3D_EmulateShaded32, M3D_EmulateTextured32, M3D_EmulateTexturedBlend32,
+    M3D_EmulateShaded32, M3D_EmulateShaded32, M3D_EmulateFiltered32, M3D_EmulateFilteredBlend32,
+    M3D_EmulateShadedZ32, M3D_EmulateShadedZ32, M3D_EmulateTexturedZ32, M3D_EmulateTexturedBlendZ32,
+    M3D_EmulateShadedZ32, M3D_EmulateShadedZ32, M3D_EmulateFilteredZ32, M3D_EmulateFilteredBlendZ32
+  }
+};
+
+/** Simple emulation of Maggie feature, the texture is DXT1 like on Maggie */
 VOID M3D_EmulateMaggie(VOID)
 {
-  UBYTE *destination, *texture, red, green ,blue;
-  LFIXED ui, vi, zi;
-  UFIXED li;
-  ULONG tex_bpr, tex_scale, index, texel;
-  UWORD *zbuffer, count;
-  BOOL draw_texel;
-
-  ui = maggie->u_start;
-  vi = maggie->v_start;
-  zi = maggie->z_start;
-  li = maggie->light_start;
-  red = (UBYTE) ((maggie->color >> 16) & 0xff);
-  green = (UBYTE) ((maggie->color >> 8) & 0xff);
-  blue = (UBYTE) (maggie->color & 0xff);
-  destination = (UBYTE *) maggie->destination;
-  zbuffer = (UWORD *) maggie->zbuffer;
-  texture = (UBYTE *) maggie->texture;
-  tex_bpr = 4 << maggie->tex_size;
-  tex_scale = 16 + (8 - maggie->tex_size);
-  count = maggie->start_length;
-  while (count--) {
-    if (texture == NULL) {
-      texel = 0xffffffff;
-    } else {
-      index = ((vi >> tex_scale) * tex_bpr) + ((ui >> tex_scale) * 4);
-      texel = (texture[index] << 24) | (texture[index+1] << 16) | (texture[index+2] << 8) | texture[index+3];
-    }
-    if ((texel & 0xff) >= 0x80) {
-      draw_texel = TRUE;
-      if (maggie->mode & M3D_M_ZBUFFER) {
-        if ((zi >> 16) > *zbuffer) {
-          draw_texel = FALSE;
-        } else {
-          *zbuffer = (zi >> 16);
-        }
-      }
-      if (draw_texel) {
-        texel >>= 8;
-        texel = M3D_MaggieBlend(texel, red, green ,blue);
-        texel = M3D_MaggieShade(texel, (UBYTE) (li >> 8));
-        if (maggie->mode & M3D_M_16BITS) {
-          M3D_Maggie16Bits((UWORD *) destination, texel);
-        } else if (maggie->mode & M3D_M_24BITS) {
-          M3D_Maggie24Bits(destination, texel);
-        } else {
-          M3D_Maggie32Bits((ULONG *) destination, texel);
-        }
-      }
-    }
-    destination += maggie->modulo;
-    zbuffer++;
-    ui += maggie->u_delta;
-    vi += maggie->v_delta;
-    zi += maggie->z_delta;
-    li += maggie->light_delta;
+  M3D_EmulatedSpan span;
+  ULONG depth, kernel = 0;
+
+  span.destination = (UBYTE *) maggie->destination;
+  span.zbuffer = (UWORD *) maggie->zbuffer;
+  span.texture = (UBYTE *) maggie->texture;
+  span.u_start = maggie->u_start;
+  span.v_start = maggie->v_start;
+  span.z_start = maggie->z_start;
+  span.u_delta = maggie->u_delta;
+  span.v_delta = maggie->v_delta;
+  span.z_delta = maggie->z_delta;
+  span.light_start = maggie->light_start;
+  span.light_delta = maggie->light_delta;
+  span.red = (maggie->color >> 16) & 0xff;
+  span.green = (maggie->color >> 8) & 0xff;
+  span.blue = maggie->color & 0xff;
+  span.color = maggie->color & 0xffffff;
+  span.modulo = maggie->modulo;
+  span.count = maggie->start_length;
+  // Texture coordinates wrap on the texture size like on Maggie
+  span.block_shift = maggie->tex_size - 2;
+  span.tex_scale = 16 + (8 - maggie->tex_size);
+  span.tex_mask = (1 << maggie->tex_size) - 1;
+  span.filter_scale = span.tex_scale - 8;
+  // The kernel is selected once for the whole span
+  if (maggie->mode & M3D_M_16BITS) {
+    depth = 0;
+  } else if (maggie->mode & M3D_M_24BITS) {
+    depth = 1;
+  } else {
+    depth = 2;
+  }
+  if (maggie->mode & M3D_M_ZBUFFER) {
+    kernel |= 8;
+  }
+  if (maggie->mode & M3D_M_BILINEAR) {
+    kernel |= 4;
+  }
+  if (span.texture != NULL) {
+    kernel |= 2;
   }
+  // A white color keeps the texel unchanged
+  if ((maggie->color & 0xffffff) != 0xffffff) {
+    kernel |= 1;
+  }
+  emulate_table[depth][kernel](&span);
 }
 #endif
 
 /*****************************************************************************/
 
-/** Swap two vertices */
-VOID M3D_SwapVertex(M3D_Vertex *va, M3D_Vertex *vb)
+/** Swap two vertex pointers */
+VOID M3D_SwapVertex(M3D_OrderedVertex **va, M3D_OrderedVertex **vb)
 {
-  M3D_Vertex vt;
-  
-  DDbug(kprintf("[MAGGIE3D] M3D_SwapVertex\n");)
-  CopyMem(va, &vt, sizeof(M3D_Vertex));
-  CopyMem(vb, va, sizeof(M3D_Vertex));
-  CopyMem(&vt, vb, sizeof(M3D_Vertex));
+  M3D_OrderedVertex *vt;
+
+  vt = *va;
+  *va = *vb;
+  *vb = vt;
 }
 
-/** Check the triangle type & order the vertices */
-ULONG M3D_CheckTriangleType(M3D_Context *context, M3D_Triangle *triangle, M3D_DrawData *draw_data)
+/** Signed area of a triangle (twice the area), positive when the vertices are clockwise on screen */
+FLOAT M3D_TriangleArea(M3D_OrderedVertex *va, M3D_OrderedVertex *vb, M3D_OrderedVertex *vc)
 {
-  // Let's start with rounded values
-  M3D_FastRoundTriangle(triangle);
-  // Degenerated triangle elimination
-  if (triangle->v1.x == triangle->v2.x && triangle->v2.x == triangle->v3.x) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because x1=x2=x3\n");)
-    return TRI_REJECTED;
+  return (vb->x - va->x) * (vc->y - va->y) - (vc->x - va->x) * (vb->y - va->y);
+}
+
+/** Check if a rounded triangle covers no pixel or is rejected by the culling states */
+BOOL M3D_CullTriangle(M3D_Context *context, M3D_OrderedVertex *va, M3D_OrderedVertex *vb, M3D_OrderedVertex *vc)
+{
+  FLOAT area;
+
+  // Rounded vertices give an exact area, collinear vertices cover no pixel (x1=x2=x3 or y1=y2=y3 included)
+  area = M3D_TriangleArea(va, vb, vc);
+  if (area == 0.0) {
+    DDbug(kprintf("[MAGGIE3D] - Rejected because the vertices are collinear\n");)
+    return TRUE;
+  }
+  if (context->states & (M3D_CULLBACK | M3D_CULLFRONT)) {
+    if ((area < 0.0 && (context->states & M3D_CULLBACK)) || (area > 0.0 && (context->states & M3D_CULLFRONT))) {
+      DDbug(kprintf("[MAGGIE3D] - Rejected by culling (area=%f)\n", area);)
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/** Check if a rounded quad covers no pixel or is rejected by the culling states, the area is given by its diagonals */
+BOOL M3D_CullQuad(M3D_Context *context, M3D_OrderedVertex *vertices)
+{
+  FLOAT area;
+
+  // Parallel diagonals cover no pixel (x1=x2=x3=x4 or y1=y2=y3=y4 included)
+  area = (vertices[2].x - vertices[0].x) * (vertices[3].y - vertices[1].y) - (vertices[3].x - vertices[1].x) * (vertices[2].y - vertices[0].y);
+  if (area == 0.0) {
+    DDbug(kprintf("[MAGGIE3D] - Rejected because the diagonals are parallel\n");)
+    return TRUE;
   }
-  if (triangle->v1.y == triangle->v2.y && triangle->v2.y == triangle->v3.y) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because y1=y2=y3\n");)
+  if (context->states & (M3D_CULLBACK | M3D_CULLFRONT)) {
+    if ((area < 0.0 && (context->states & M3D_CULLBACK)) || (area > 0.0 && (context->states & M3D_CULLFRONT))) {
+      DDbug(kprintf("[MAGGIE3D] - Rejected by culling (area=%f)\n", area);)
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/** Check the triangle type & order its vertices */
+ULONG M3D_CheckTriangleType(M3D_Context *context, M3D_Triangle *triangle, M3D_OrderedTriangle *ordered, M3D_DrawData *draw_data)
+{
+  // Let's start with rounded values, kept in the ordered triangle
+  M3D_FastRoundVertices(&(triangle->v1), ordered->crd, 3);
+  if (M3D_CullTriangle(context, &(ordered->crd[0]), &(ordered->crd[1]), &(ordered->crd[2]))) {
     return TRI_REJECTED;
   }
+  ordered->v1 = &(ordered->crd[0]);
+  ordered->v2 = &(ordered->crd[1]);
+  ordered->v3 = &(ordered->crd[2]);
+  ordered->texture = triangle->texture;
+  ordered->color = triangle->color;
+  return M3D_SortTriangle(context, ordered, draw_data);
+}
+
+/** Check the type & order the vertex pointers of an already rounded triangle */
+ULONG M3D_SortTriangle(M3D_Context *context, M3D_OrderedTriangle *triangle, M3D_DrawData *draw_data)
+{
+  // Degenerated triangles are already eliminated by M3D_CullTriangle
   // Order triangle vertices from top to bottom
-  if (triangle->v1.y > triangle->v3.y) {
+  if (triangle->v1->y > triangle->v3->y) {
     M3D_SwapVertex(&(triangle->v1), &(triangle->v3));
   }
-  if (triangle->v1.y > triangle->v2.y) {
+  if (triangle->v1->y > triangle->v2->y) {
     M3D_SwapVertex(&(triangle->v1), &(triangle->v2));
   }
-  if (triangle->v2.y > triangle->v3.y) {
+  if (triangle->v2->y > triangle->v3->y) {
     M3D_SwapVertex(&(triangle->v2), &(triangle->v3));
   }
   DDbug(kprintf("[MAGGIE3D] - Triangle ordered\n");)
   DDbug(M3D_DumpTriangle(triangle);)
-  // Trivial rejection
-  if (triangle->v3.y < draw_data->top_clip || triangle->v1.y > draw_data->bottom_clip) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because y3 < top_clip or y1 > bottom_clip\n");)
+  // Trivial rejection, the lines from y1 to y3 - 1 & the pixels from xl to xr - 1 are drawn
+  if (triangle->v3->y <= draw_data->top_clip || triangle->v1->y >= draw_data->bottom_clip) {
+    DDbug(kprintf("[MAGGIE3D] - Rejected because y3 <= top_clip or y1 >= bottom_clip\n");)
     return TRI_REJECTED;
   }
-  if (triangle->v1.x < draw_data->left_clip && triangle->v2.x < draw_data->left_clip && triangle->v3.x < draw_data->left_clip) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because x1,x2 & x3 < left_clip\n");)
+  if (triangle->v1->x <= draw_data->left_clip && triangle->v2->x <= draw_data->left_clip && triangle->v3->x <= draw_data->left_clip) {
+    DDbug(kprintf("[MAGGIE3D] - Rejected because x1,x2 & x3 <= left_clip\n");)
     return TRI_REJECTED;
   }
-  if (triangle->v1.x > draw_data->right_clip && triangle->v2.x > draw_data->right_clip && triangle->v3.x > draw_data->right_clip) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because x1,x2 & x3 > right_clip\n");)
+  if (triangle->v1->x >= draw_data->right_clip && triangle->v2->x >= draw_data->right_clip && triangle->v3->x >= draw_data->right_clip) {
+    DDbug(kprintf("[MAGGIE3D] - Rejected because x1,x2 & x3 >= right_clip\n");)
     return TRI_REJECTED;
   }
+  M3D_CheckInside(&(triangle->v1), 3, draw_data);
   // Check the type & order from left to right
-  if (triangle->v1.y == triangle->v2.y) {
-    if (triangle->v1.x > triangle->v2.x) {
+  if (triangle->v1->y == triangle->v2->y) {
+    if (triangle->v1->x > triangle->v2->x) {
       M3D_SwapVertex(&(triangle->v1), &(triangle->v2));
     }
     return TRI_FLATTOP;
-  } else if (triangle->v2.y == triangle->v3.y) {
-    if (triangle->v2.x > triangle->v3.x) {
+  } else if (triangle->v2->y == triangle->v3->y) {
+    if (triangle->v2->x > triangle->v3->x) {
       M3D_SwapVertex(&(triangle->v2), &(triangle->v3));
     }
     return TRI_FLATBOTTOM;
@@ -309,174 +499,640 @@ ULONG M3D_CheckTriangleType(M3D_Context *context, M3D_Triangle *triangle, M3D_Dr
   return TRI_GENERIC;
 }
 
-/** Check the quad type & order the vertices */
-ULONG M3D_CheckQuadType(M3D_Context *context, M3D_Quad *quad, M3D_DrawData *draw_data)
+/** Check if the spans of a rounded figure stay inside the clipping region, with one pixel of margin for the edges */
+VOID M3D_CheckInside(M3D_OrderedVertex **vertices, ULONG count, M3D_DrawData *draw_data)
 {
-  ULONG type, minv, vertex_size;
-  FLOAT miny, vec1, vec2;
-  M3D_Vertex tmp_vx;
+  ULONG index;
 
-  // Let's start with rounded values
-  M3D_FastRoundQuad(quad);
-  // Degenerated quad elimination
-  if (quad->v1.x == quad->v2.x && quad->v2.x == quad->v3.x && quad->v3.x == quad->v4.x) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because x1=x2=x3=x4\n");)
-    return QUAD_REJECTED;
+  draw_data->inside = TRUE;
+  for (index = 0;index < count;index++) {
+    if (vertices[index]->x <= draw_data->left_clip || vertices[index]->x >= draw_data->right_clip) {
+      DDbug(kprintf("[MAGGIE3D] - Spans clipped\n");)
+      draw_data->inside = FALSE;
+      return;
+    }
   }
-  if (quad->v1.y == quad->v2.y && quad->v2.y == quad->v3.y && quad->v3.y == quad->v4.y) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because y1=y2=y3=y4\n");)
+}
+
+/** Check the quad type & order its vertices */
+ULONG M3D_CheckQuadType(M3D_Context *context, M3D_Quad *quad, M3D_OrderedQuad *ordered, M3D_DrawData *draw_data)
+{
+  ULONG type, minv;
+  FLOAT miny, vec1, vec2;
+  M3D_OrderedVertex *vt, *crd;
+
+  // Let's start with rounded values, kept in the ordered quad
+  crd = ordered->crd;
+  M3D_FastRoundVertices(&(quad->v1), crd, 4);
+  if (M3D_CullQuad(context, crd)) {
     return QUAD_REJECTED;
   }
-  // Trivial rejection
-  if (quad->v1.x < draw_data->left_clip && quad->v2.x < draw_data->left_clip && quad->v3.x < draw_data->left_clip && quad->v4.x < draw_data->left_clip) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because x1,x2,x3 & x4 < left_clip\n");)
+  // Trivial rejection, the figure must cover at least one line & one column of the clipping region
+  if (crd[0].x <= draw_data->left_clip && crd[1].x <= draw_data->left_clip && crd[2].x <= draw_data->left_clip && crd[3].x <= draw_data->left_clip) {
+    DDbug(kprintf("[MAGGIE3D] - Rejected because x1,x2,x3 & x4 <= left_clip\n");)
     return QUAD_REJECTED;
   }
-  if (quad->v1.x >= draw_data->right_clip && quad->v2.x >= draw_data->right_clip && quad->v3.x >= draw_data->right_clip && quad->v4.x >= draw_data->right_clip) {
+  if (crd[0].x >= draw_data->right_clip && crd[1].x >= draw_data->right_clip && crd[2].x >= draw_data->right_clip && crd[3].x >= draw_data->right_clip) {
     DDbug(kprintf("[MAGGIE3D] - Rejected because x1,x2,x3 & x4 >= right_clip\n");)
     return QUAD_REJECTED;
   }
-  if (quad->v1.y < draw_data->top_clip && quad->v2.y < draw_data->top_clip && quad->v3.y < draw_data->top_clip && quad->v4.y < draw_data->top_clip) {
-    DDbug(kprintf("[MAGGIE3D] - Rejected because y1,y2,y3 & y4 < top_clip\n");)
+  if (crd[0].y <= draw_data->top_clip && crd[1].y <= draw_data->top_clip && crd[2].y <= draw_data->top_clip && crd[3].y <= draw_data->top_clip) {
+    DDbug(kprintf("[MAGGIE3D] - Rejected because y1,y2,y3 & y4 <= top_clip\n");)
     return QUAD_REJECTED;
   }
+  ordered->v1 = &(crd[0]);
+  ordered->v2 = &(crd[1]);
+  ordered->v3 = &(crd[2]);
+  ordered->v4 = &(crd[3]);
+  ordered->texture = quad->texture;
+  ordered->color = quad->color;
   // Order in clock wise
-  vec1 = (quad->v1.y - quad->v2.y) * (quad->v2.x - quad->v4.x);
-  vec2 = (quad->v2.y - quad->v4.y) * (quad->v1.x - quad->v2.x);
+  vec1 = (crd[0].y - crd[1].y) * (crd[1].x - crd[3].x);
+  vec2 = (crd[1].y - crd[3].y) * (crd[0].x - crd[1].x);
   if (vec1 > vec2) {
-    M3D_SwapVertex(&(quad->v2), &(quad->v4));
+    M3D_SwapVertex(&(ordered->v2), &(ordered->v4));
   }
   DDbug(kprintf("[MAGGIE3D] - Quad in clock wise\n");)
-  DDbug(M3D_DumpQuad(quad);)
+  DDbug(M3D_DumpQuad(ordered);)
   // Order quad vertices from top to bottom
   minv = 1;
-  miny = quad->v1.y;
-  if (quad->v2.y < miny) { minv = 2; miny = quad->v2.y; }
-  if (quad->v3.y < miny) { minv = 3; miny = quad->v3.y; }
-  if (quad->v4.y < miny) { minv = 4; miny = quad->v4.y; }
+  miny = ordered->v1->y;
+  if (ordered->v2->y < miny) { minv = 2; miny = ordered->v2->y; }
+  if (ordered->v3->y < miny) { minv = 3; miny = ordered->v3->y; }
+  if (ordered->v4->y < miny) { minv = 4; miny = ordered->v4->y; }
   DDbug(kprintf("[MAGGIE3D] - Min Y=%f (vertex %d)\n", miny, minv);)
   if (miny >= draw_data->bottom_clip) {
     DDbug(kprintf("[MAGGIE3D] - Rejected because y1,y2,y3 & y4 >= bottom_clip\n");)
     return QUAD_REJECTED;
   }
-  vertex_size = sizeof(M3D_Vertex);
+  M3D_CheckInside(&(ordered->v1), 4, draw_data);
   if (minv == 2) {
-    CopyMem(&(quad->v1), &tmp_vx, vertex_size);
-    CopyMem(&(quad->v2), &(quad->v1), vertex_size);
-    CopyMem(&(quad->v3), &(quad->v2), vertex_size);
-    CopyMem(&(quad->v4), &(quad->v3), vertex_size);
-    CopyMem(&tmp_vx, &(quad->v4), vertex_size);
+    vt = ordered->v1;
+    ordered->v1 = ordered->v2;
+    ordered->v2 = ordered->v3;
+    ordered->v3 = ordered->v4;
+    ordered->v4 = vt;
   } else if (minv == 3) {
-    CopyMem(&(quad->v1), &tmp_vx, vertex_size);
-    CopyMem(&(quad->v3), &(quad->v1), vertex_size);
-    CopyMem(&tmp_vx, &(quad->v3), vertex_size);
-    CopyMem(&(quad->v2), &tmp_vx, vertex_size);
-    CopyMem(&(quad->v4), &(quad->v2), vertex_size);
-    CopyMem(&tmp_vx, &(quad->v4), vertex_size);
+    M3D_SwapVertex(&(ordered->v1), &(ordered->v3));
+    M3D_SwapVertex(&(ordered->v2), &(ordered->v4));
   } else if (minv == 4) {
-    CopyMem(&(quad->v4), &tmp_vx, vertex_size);
-    CopyMem(&(quad->v3), &(quad->v4), vertex_size);
-    CopyMem(&(quad->v2), &(quad->v3), vertex_size);
-    CopyMem(&(quad->v1), &(quad->v2), vertex_size);
-    CopyMem(&tmp_vx, &(quad->v1), vertex_size);
+    vt = ordered->v4;
+    ordered->v4 = ordered->v3;
+    ordered->v3 = ordered->v2;
+    ordered->v2 = ordered->v1;
+    ordered->v1 = vt;
   }
   DDbug(kprintf("[MAGGIE3D] - Quad ordered\n");)
-  DDbug(M3D_DumpQuad(quad);)
+  DDbug(M3D_DumpQuad(ordered);)
   type = QUAD_GENERIC;
   // Check the type & order vertices
-  if (quad->v1.y == quad->v2.y) {
+  if (ordered->v1->y == ordered->v2->y) {
     type |= QUAD_FLATTOP;
-  } else if (quad->v1.y == quad->v4.y) {
-    CopyMem(&(quad->v4), &tmp_vx, vertex_size);
-    CopyMem(&(quad->v3), &(quad->v4), vertex_size);
-    CopyMem(&(quad->v2), &(quad->v3), vertex_size);
-    CopyMem(&(quad->v1), &(quad->v2), vertex_size);
-    CopyMem(&tmp_vx, &(quad->v1), vertex_size);
+  } else if (ordered->v1->y == ordered->v4->y) {
+    vt = ordered->v4;
+    ordered->v4 = ordered->v3;
+    ordered->v3 = ordered->v2;
+    ordered->v2 = ordered->v1;
+    ordered->v1 = vt;
     type |= QUAD_FLATTOP;
   }
-  if (quad->v2.y == quad->v3.y) {
+  if (ordered->v2->y == ordered->v3->y) {
     type |= QUAD_FLATBOTTOM;
-  } else if (quad->v3.y == quad->v4.y) {
+  } else if (ordered->v3->y == ordered->v4->y) {
     type |= QUAD_FLATBOTTOM;
   }
-  DDbug(M3D_DumpQuad(quad);)
+  DDbug(M3D_DumpQuad(ordered);)
   return type;
 }
 
 /*****************************************************************************/
-/**                  DRAW SHADED TRIANGLE                                    */
+/**                  SHARED VERTICES                                         */
 /*****************************************************************************/
 
-/** Draw a shaded triangle */
-VOID M3D_DrawShadedTriangle(M3D_Context *context, M3D_Triangle *triangle, M3D_DrawData *draw_data, ULONG type)
+/** Setup the Maggie mode & the drawing constants of the context */
+VOID M3D_SetupDrawData(M3D_Context *context, M3D_DrawData *draw_data)
 {
-  // Setup Maggie registers
-  maggie->texture = (APTR) context->flat_shading;;
-  maggie->tex_size = M3D_TEX64;
-  maggie->color = triangle->color;
-  // Render the triangle depending on his type
-  if (type == TRI_FLATTOP) {
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawGouraudShadedTop(context, triangle, draw_data);
-    } else {
-      M3D_DrawFlatShadedTop(context, triangle, draw_data);
+  M3D_SetReg(mode, context->mode);
+  M3D_SetReg(modulo, context->drawregion.bpp);
+  // Setup clip constants
+  draw_data->left_clip = (FLOAT) context->clipping.left;
+  draw_data->top_clip = (FLOAT) context->clipping.top;
+  draw_data->right_clip = (FLOAT) (context->clipping.left + context->clipping.width);
+  draw_data->bottom_clip = (FLOAT) (context->clipping.top + context->clipping.height);
+  // Setup constants
+  draw_data->dest_bpr = context->drawregion.bpr;
+  draw_data->dest_bpp = context->drawregion.bpp;
+  draw_data->zbuf_bpr = context->zbuffer.bpr;
+  draw_data->zbuf_bpp = context->zbuffer.bpp;
+  // Binned spans are queued in the context & clipped to the tiles when the bins are drawn
+  draw_data->bins = ((context->states & M3D_BINNING) && !context->scene) ? context : NULL;
+  draw_data->span_queue = (draw_data->bins != NULL || (context->states & M3D_SPANQUEUE)) ? TRUE : FALSE;
+  // Hierarchical Z buffer is only used when the Z buffer is tested
+  draw_data->hiz = (context->mode & M3D_M_ZBUFFER) ? (M3D_HiZTile *) context->hiz_data : NULL;
+  draw_data->hiz_width = context->hiz_width;
+  draw_data->hiz_update = FALSE;
+}
+
+/** Round & compute the clipping codes of an array of vertices only once, frustum codes in M3D_FRUSTUMCLIP state */
+UBYTE *M3D_PrepareVertices(M3D_Context *context, M3D_Vertex *vertices, M3D_OrderedVertex **prepared, ULONG count, M3D_DrawData *draw_data)
+{
+  M3D_OrderedVertex *vertex;
+  UBYTE *clip, code;
+  ULONG index;
+
+  // Grow the vertex buffer of the context if needed
+  if (count > context->vertex_buffer_size) {
+    if (context->vertex_buffer != NULL) {
+      M3D_FreeMem(context->vertex_buffer);
     }
-  } else if (type == TRI_FLATBOTTOM) {
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawGouraudShadedBottom(context, triangle, draw_data);
-    } else {
-      M3D_DrawFlatShadedBottom(context, triangle, draw_data);
+    context->vertex_buffer = M3D_AllocMem(count * (sizeof(M3D_OrderedVertex) + 1));
+    if (context->vertex_buffer == NULL) {
+      context->vertex_buffer_size = 0;
+      return NULL;
     }
-  } else if (type == TRI_GENERIC) {
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawGouraudShadedGeneric(context, triangle, draw_data);
-    } else {
-      M3D_DrawFlatShadedGeneric(context, triangle, draw_data);
+    context->vertex_buffer_size = count;
+  }
+  *prepared = (M3D_OrderedVertex *) context->vertex_buffer;
+  clip = (UBYTE *) context->vertex_buffer + (count * sizeof(M3D_OrderedVertex));
+  if (context->states & M3D_FRUSTUMCLIP) {
+    // Vertices are rounded once projected by the clipping of each triangle
+    for (index = 0;index < count;index++) {
+      (*prepared)[index].vertex = &(vertices[index]);
+      clip[index] = M3D_FrustumCode(&(vertices[index]));
+    }
+    return clip;
+  }
+  // The rounded coordinates are kept in the buffer, the caller's vertices are never modified
+  M3D_FastRoundVertices(vertices, *prepared, count);
+  // Z is remapped once at draw time, the scene figures are remapped when the scene is drawn
+  if (context->zbuffer_frames > 1 && !context->scene) {
+    M3D_RemapZ(context, *prepared, count);
+  }
+  vertex = *prepared;
+  for (index = 0;index < count;index++) {
+    code = 0;
+    if (vertex->x < draw_data->left_clip) {
+      code |= CLIP_LEFT;
+    } else if (vertex->x > draw_data->right_clip) {
+      code |= CLIP_RIGHT;
     }
+    if (vertex->y < draw_data->top_clip) {
+      code |= CLIP_TOP;
+    } else if (vertex->y > draw_data->bottom_clip) {
+      code |= CLIP_BOTTOM;
+    }
+    clip[index] = code;
+    vertex++;
   }
+  return clip;
 }
 
 /*****************************************************************************/
-/**                      DRAW SHADED QUAD                                    */
+/**                  Z BUFFER                                                */
 /*****************************************************************************/
 
-/** Draw a shaded quad */
-VOID M3D_DrawShadedQuad(M3D_Context *context, M3D_Quad *quad, M3D_DrawData *draw_data, ULONG type)
+/** Move the Z values of ordered vertices in the depth band of the current frame */
+VOID M3D_RemapZ(M3D_Context *context, M3D_OrderedVertex *vertices, ULONG count)
 {
-  // Setup Maggie registers
-  maggie->texture = (APTR) context->flat_shading;;
-  maggie->tex_size = M3D_TEX64;
-  maggie->color = quad->color;
-  // Render the quad depending on his type
-  if (type == QUAD_FLATTOP) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawQuadFlatTop\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudShadedTop(context, quad, draw_data);
-    } else {
-      M3D_DrawQuadFlatShadedTop(context, quad, draw_data);
+  while (count--) {
+    vertices->z = (vertices->z * context->z_scale) + context->z_offset;
+    vertices++;
+  }
+}
+
+/** Reset all the tiles of the hierarchical Z buffer after a Z buffer clear */
+VOID M3D_ClearHiZ(M3D_Context *context)
+{
+  M3D_HiZTile *tile;
+  ULONG count;
+
+  tile = (M3D_HiZTile *) context->hiz_data;
+  if (tile != NULL) {
+    count = context->hiz_width * context->hiz_height;
+    while (count--) {
+      tile->max = ZBUF_CLEARVAL;
+      tile->pending = 0;
+      tile->rows = 0;
+      tile++;
+    }
+  }
+}
+
+/** Check the bounding box of a figure against the hierarchical Z buffer, FALSE if the figure is hidden */
+BOOL M3D_HiZFigure(M3D_Context *context, M3D_DrawData *draw_data, M3D_OrderedVertex **vertices, ULONG count, M3D_Texture *texture)
+{
+  M3D_HiZTile *tile;
+  FLOAT min_x, min_y, max_x, max_y, min_z;
+  LONG left, top, right, bottom, z, x, y;
+  ULONG index;
+
+  if (draw_data->hiz == NULL) {
+    return TRUE;
+  }
+  // Transparent texels do not write the Z buffer
+  draw_data->hiz_update = !(context->mode & M3D_M_INHIBZBUF);
+  if ((context->states & M3D_TEXMAPPING) && texture != NULL && texture->transparency) {
+    draw_data->hiz_update = FALSE;
+  }
+  // Bounding box & nearest Z of the figure
+  min_x = max_x = vertices[0]->x;
+  min_y = max_y = vertices[0]->y;
+  min_z = vertices[0]->z;
+  for (index = 1;index < count;index++) {
+    if (vertices[index]->x < min_x) {
+      min_x = vertices[index]->x;
+    } else if (vertices[index]->x > max_x) {
+      max_x = vertices[index]->x;
+    }
+    if (vertices[index]->y < min_y) {
+      min_y = vertices[index]->y;
+    } else if (vertices[index]->y > max_y) {
+      max_y = vertices[index]->y;
+    }
+    if (vertices[index]->z < min_z) {
+      min_z = vertices[index]->z;
+    }
+  }
+  if (min_x < draw_data->left_clip) {
+    min_x = draw_data->left_clip;
+  }
+  if (max_x >= draw_data->right_clip) {
+    max_x = draw_data->right_clip - 1.0;
+  }
+  if (min_y < draw_data->top_clip) {
+    min_y = draw_data->top_clip;
+  }
+  if (max_y >= draw_data->bottom_clip) {
+    max_y = draw_data->bottom_clip - 1.0;
+  }
+  // Keep one unit of margin for the rounding of the spans
+  z = (LONG) min_z - 1;
+  left = (LONG) min_x / HIZ_WIDTH;
+  right = (LONG) max_x / HIZ_WIDTH;
+  top = (LONG) min_y / HIZ_HEIGHT;
+  bottom = (LONG) max_y / HIZ_HEIGHT;
+  for (y = top;y <= bottom;y++) {
+    tile = draw_data->hiz + (y * draw_data->hiz_width) + left;
+    for (x = left;x <= right;x++) {
+      if (z <= (LONG) tile->max) {
+        return TRUE;
+      }
+      tile++;
     }
-  } else if (type == QUAD_FLATBOTTOM) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawQuadFlatBottom\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudShadedBottom(context, quad, draw_data);
+  }
+  DDbug(kprintf("[MAGGIE3D] - Rejected by the hierarchical Z buffer\n");)
+  return FALSE;
+}
+
+/** Check a span against the hierarchical Z buffer & update the tiles it covers, FALSE if the span is hidden */
+BOOL M3D_HiZSpan(M3D_DrawData *draw_data, ULONG y, LONG xs, LONG length, LFIXED zi, LFIXED dz)
+{
+  M3D_HiZTile *tile;
+  LONG x, xe, end, z_min, z_max;
+  LFIXED z_first, z_last;
+  UBYTE row;
+  BOOL visible;
+
+  tile = draw_data->hiz + ((y / HIZ_HEIGHT) * draw_data->hiz_width) + (xs / HIZ_WIDTH);
+  row = (UBYTE) (1 << (y % HIZ_HEIGHT));
+  visible = FALSE;
+  xe = xs + length;
+  for (x = xs;x < xe;x = end) {
+    end = (x / HIZ_WIDTH + 1) * HIZ_WIDTH;
+    if (end > xe) {
+      end = xe;
+    }
+    // Z range of the span inside the tile
+    z_first = zi + ((x - xs) * dz);
+    z_last = zi + ((end - 1 - xs) * dz);
+    if (z_first < z_last) {
+      z_min = z_first >> 16;
+      z_max = z_last >> 16;
     } else {
-      M3D_DrawQuadFlatShadedBottom(context, quad, draw_data);
+      z_min = z_last >> 16;
+      z_max = z_first >> 16;
+    }
+    if (z_min <= (LONG) tile->max) {
+      visible = TRUE;
+      // A line fully covered by the span can only hold Z values below the span ones
+      if (draw_data->hiz_update && z_min >= 0 && end - x == HIZ_WIDTH) {
+        if (z_max > (LONG) tile->pending) {
+          tile->pending = (UWORD) z_max;
+        }
+        tile->rows |= row;
+        if (tile->rows == HIZ_ROWS) {
+          if (tile->pending < tile->max) {
+            tile->max = tile->pending;
+          }
+          tile->pending = 0;
+          tile->rows = 0;
+        }
+      }
     }
-  } else if (type == QUAD_FLATBOTH) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawQuadFlatBoth\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudShadedBoth(context, quad, draw_data);
+    tile++;
+  }
+  return visible;
+}
+
+/*****************************************************************************/
+/**                  GRADIENTS SETUP                                         */
+/*****************************************************************************/
+
+/** Compute the screen gradients of Z, U, V & L from three vertices */
+BOOL M3D_SetupGradients(M3D_OrderedVertex *va, M3D_OrderedVertex *vb, M3D_OrderedVertex *vc, M3D_DrawData *draw_data)
+{
+  FLOAT dx1, dy1, dx2, dy2, area;
+  FLOAT da1, da2;
+
+  dx1 = vb->x - va->x;
+  dy1 = vb->y - va->y;
+  dx2 = vc->x - va->x;
+  dy2 = vc->y - va->y;
+  area = (dx1 * dy2) - (dx2 * dy1);
+  if (area == 0.0) {
+    DDbug(kprintf("[MAGGIE3D] - No gradients because of null area\n");)
+    return FALSE;
+  }
+  area = 1.0 / area;
+  // Z gradients
+  da1 = vb->z - va->z;
+  da2 = vc->z - va->z;
+  draw_data->grad_dzdx = ((da1 * dy2) - (da2 * dy1)) * area;
+  draw_data->grad_dzdy = ((da2 * dx1) - (da1 * dx2)) * area;
+  // U gradients
+  da1 = vb->vertex->u - va->vertex->u;
+  da2 = vc->vertex->u - va->vertex->u;
+  draw_data->grad_dudx = ((da1 * dy2) - (da2 * dy1)) * area;
+  draw_data->grad_dudy = ((da2 * dx1) - (da1 * dx2)) * area;
+  // V gradients
+  da1 = vb->vertex->v - va->vertex->v;
+  da2 = vc->vertex->v - va->vertex->v;
+  draw_data->grad_dvdx = ((da1 * dy2) - (da2 * dy1)) * area;
+  draw_data->grad_dvdy = ((da2 * dx1) - (da1 * dx2)) * area;
+  // Light gradients
+  da1 = vb->vertex->light - va->vertex->light;
+  da2 = vc->vertex->light - va->vertex->light;
+  draw_data->grad_dldx = ((da1 * dy2) - (da2 * dy1)) * area;
+  draw_data->grad_dldy = ((da2 * dx1) - (da1 * dx2)) * area;
+  return TRUE;
+}
+
+/** Compute the screen gradients of a quad, only when its attributes are planar */
+BOOL M3D_SetupQuadGradients(M3D_OrderedQuad *quad, M3D_DrawData *draw_data, BOOL textured)
+{
+  M3D_OrderedVertex *vd;
+  FLOAT dx, dy;
+
+  // Use the first non degenerated triangle and check the remaining vertex
+  if (M3D_SetupGradients(quad->v1, quad->v2, quad->v3, draw_data)) {
+    vd = quad->v4;
+  } else if (M3D_SetupGradients(quad->v1, quad->v3, quad->v4, draw_data)) {
+    vd = quad->v2;
+  } else {
+    return FALSE;
+  }
+  dx = vd->x - quad->v1->x;
+  dy = vd->y - quad->v1->y;
+  if (fabs(quad->v1->z + (dx * draw_data->grad_dzdx) + (dy * draw_data->grad_dzdy) - vd->z) > PLANE_Z_EPSILON) {
+    return FALSE;
+  }
+  if (fabs(quad->v1->vertex->light + (dx * draw_data->grad_dldx) + (dy * draw_data->grad_dldy) - vd->vertex->light) > PLANE_L_EPSILON) {
+    return FALSE;
+  }
+  if (textured) {
+    if (fabs(quad->v1->vertex->u + (dx * draw_data->grad_dudx) + (dy * draw_data->grad_dudy) - vd->vertex->u) * draw_data->scale > PLANE_UV_EPSILON) {
+      return FALSE;
+    }
+    if (fabs(quad->v1->vertex->v + (dx * draw_data->grad_dvdx) + (dy * draw_data->grad_dvdy) - vd->vertex->v) * draw_data->scale > PLANE_UV_EPSILON) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+/** Check that the X edges & the Z steps of a figure part can be walked in 16:16 fixed point */
+BOOL M3D_FixedEdges(UWORD nblines, M3D_DrawData *draw_data)
+{
+  FLOAT xl, xr;
+
+  // The edges are straight, their two ends are enough
+  xl = draw_data->crd_xl + (draw_data->delta_dxdyl * nblines);
+  xr = draw_data->crd_xr + (draw_data->delta_dxdyr * nblines);
+  if (FIXED_FITS(draw_data->crd_xl) && FIXED_FITS(draw_data->crd_xr) && FIXED_FITS(xl) && FIXED_FITS(xr)
+      && FIXED_FITS(draw_data->delta_dxdyl) && FIXED_FITS(draw_data->delta_dxdyr)
+      && FIXED_FITS(draw_data->delta_dzdyl) && FIXED_FITS(draw_data->delta_dzdyr)
+      && (!draw_data->grad_const || FIXED_FITS(draw_data->grad_dzdx))) {
+    return TRUE;
+  }
+  DDbug(kprintf("[MAGGIE3D] - Edges out of the fixed point range\n");)
+  return FALSE;
+}
+
+/*****************************************************************************/
+/**                  PERSPECTIVE CORRECTION                                  */
+/*****************************************************************************/
+
+/** Setup the screen planes of 1/W, U/W & V/W from three vertices */
+BOOL M3D_SetupPerspective(M3D_OrderedVertex *va, M3D_OrderedVertex *vb, M3D_OrderedVertex *vc, M3D_DrawData *draw_data)
+{
+  FLOAT dx1, dy1, dx2, dy2, area;
+  FLOAT wa, wb, wc, da1, da2;
+  FLOAT ua, ub, uc, ta, tb, tc;
+
+  // Vertices behind the eye can't be corrected
+  if (va->vertex->w <= 0.0 || vb->vertex->w <= 0.0 || vc->vertex->w <= 0.0) {
+    DDbug(kprintf("[MAGGIE3D] - No perspective because of negative W\n");)
+    return FALSE;
+  }
+  dx1 = vb->x - va->x;
+  dy1 = vb->y - va->y;
+  dx2 = vc->x - va->x;
+  dy2 = vc->y - va->y;
+  area = (dx1 * dy2) - (dx2 * dy1);
+  if (area == 0.0) {
+    DDbug(kprintf("[MAGGIE3D] - No perspective because of null area\n");)
+    return FALSE;
+  }
+  area = 1.0 / area;
+  // 1/W plane
+  wa = 1.0 / va->vertex->w;
+  wb = 1.0 / vb->vertex->w;
+  wc = 1.0 / vc->vertex->w;
+  da1 = wb - wa;
+  da2 = wc - wa;
+  draw_data->pln_dwdx = ((da1 * dy2) - (da2 * dy1)) * area;
+  draw_data->pln_dwdy = ((da2 * dx1) - (da1 * dx2)) * area;
+  draw_data->pln_w = wa - (va->x * draw_data->pln_dwdx) - (va->y * draw_data->pln_dwdy);
+  // U/W plane (in Maggie register unit)
+  ua = va->vertex->u * draw_data->scale * wa;
+  ub = vb->vertex->u * draw_data->scale * wb;
+  uc = vc->vertex->u * draw_data->scale * wc;
+  da1 = ub - ua;
+  da2 = uc - ua;
+  draw_data->pln_dudx = ((da1 * dy2) - (da2 * dy1)) * area;
+  draw_data->pln_dudy = ((da2 * dx1) - (da1 * dx2)) * area;
+  draw_data->pln_u = ua - (va->x * draw_data->pln_dudx) - (va->y * draw_data->pln_dudy);
+  // V/W plane (in Maggie register unit)
+  ta = va->vertex->v * draw_data->scale * wa;
+  tb = vb->vertex->v * draw_data->scale * wb;
+  tc = vc->vertex->v * draw_data->scale * wc;
+  da1 = tb - ta;
+  da2 = tc - ta;
+  draw_data->pln_dvdx = ((da1 * dy2) - (da2 * dy1)) * area;
+  draw_data->pln_dvdy = ((da2 * dx1) - (da1 * dx2)) * area;
+  draw_data->pln_v = ta - (va->x * draw_data->pln_dvdx) - (va->y * draw_data->pln_dvdy);
+  return TRUE;
+}
+
+/** Render a perspective corrected span as a serie of affine sub spans */
+VOID M3D_PerspectiveSpan(M3D_DrawData *draw_data, FLOAT xs, UWORD length, ULONG dest, ULONG zbuf, LFIXED zi, LFIXED dz, UFIXED li, SFIXED dl)
+{
+  FLOAT wi, uw, vw, dw, duw, dvw;
+  FLOAT rw, us, vs, ue, ve, inv;
+  LFIXED du, dv;
+  UWORD count;
+  M3D_SpanCmd *span;
+
+  // Planes value at the first pixel of the span
+  wi = draw_data->pln_w + (xs * draw_data->pln_dwdx) + (draw_data->crd_y * draw_data->pln_dwdy);
+  uw = draw_data->pln_u + (xs * draw_data->pln_dudx) + (draw_data->crd_y * draw_data->pln_dudy);
+  vw = draw_data->pln_v + (xs * draw_data->pln_dvdx) + (draw_data->crd_y * draw_data->pln_dvdy);
+  // Planes step for a full sub span
+  dw = draw_data->pln_dwdx * draw_data->persp_len;
+  duw = draw_data->pln_dudx * draw_data->persp_len;
+  dvw = draw_data->pln_dvdx * draw_data->persp_len;
+  rw = 1.0 / wi;
+  us = uw * rw;
+  vs = vw * rw;
+  while (length) {
+    if (length > draw_data->persp_len) {
+      count = draw_data->persp_len;
+      inv = draw_data->persp_inv;
+      wi += dw;
+      uw += duw;
+      vw += dvw;
     } else {
-      M3D_DrawQuadFlatShadedBoth(context, quad, draw_data);
+      count = length;
+      inv = 1.0 / count;
+      wi += draw_data->pln_dwdx * count;
+      uw += draw_data->pln_dudx * count;
+      vw += draw_data->pln_dvdx * count;
     }
-  } else if (type == QUAD_GENERIC) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawQuadGeneric\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudShadedGeneric(context, quad, draw_data);
+    // Only one division per sub span
+    rw = 1.0 / wi;
+    ue = uw * rw;
+    ve = vw * rw;
+    du = (LFIXED) ((ue - us) * inv);
+    dv = (LFIXED) ((ve - vs) * inv);
+    if (draw_data->span_queue) {
+      span = M3D_FigureSpan(draw_data);
+      span->destination = (APTR) dest;
+      span->zbuffer = (APTR) zbuf;
+      span->u_start = (LFIXED) us;
+      span->v_start = (LFIXED) vs;
+      span->u_delta = du;
+      span->v_delta = dv;
+      span->light_start = li;
+      span->light_delta = dl;
+      span->z_start = zi;
+      span->z_delta = dz;
+      span->length = count;
     } else {
-      M3D_DrawQuadFlatShadedGeneric(context, quad, draw_data);
+      maggie->destination = (APTR) dest;
+      maggie->zbuffer = (APTR) zbuf;
+      maggie->u_start = (LFIXED) us;
+      maggie->v_start = (LFIXED) vs;
+      M3D_SetReg(u_delta, du);
+      M3D_SetReg(v_delta, dv);
+      maggie->light_start = li;
+      M3D_SetReg(light_delta, dl);
+      maggie->z_start = zi;
+      M3D_SetReg(z_delta, dz);
+      WaitBlit();
+      maggie->start_length = count;
+#if _USE_MAGGIE_ == 0
+      M3D_EmulateMaggie();
+#endif
     }
+    DDbug(kprintf("[MAGGIE3D] => Rendering %d perspective texels\n", count);)
+    // Next sub span
+    dest += count * draw_data->dest_bpp;
+    zbuf += count * draw_data->zbuf_bpp;
+    zi += dz * count;
+    li += dl * count;
+    us = ue;
+    vs = ve;
+    length -= count;
+  }
+}
+
+/*****************************************************************************/
+/**                         SPAN KERNELS                                     */
+/*****************************************************************************/
+
+// Span kernels indexed by the shading mode (textured << 1 | gouraud), then by the figure type
+M3D_Kernels kernel_table[4] = {
+  {
+    { NULL, M3D_DrawFlatShadedTop, M3D_DrawFlatShadedBottom, M3D_DrawFlatShadedGeneric },
+    { M3D_DrawQuadFlatShadedGeneric, M3D_DrawQuadFlatShadedTop, M3D_DrawQuadFlatShadedBottom, M3D_DrawQuadFlatShadedBoth }
+  },
+  {
+    { NULL, M3D_DrawGouraudShadedTop, M3D_DrawGouraudShadedBottom, M3D_DrawGouraudShadedGeneric },
+    { M3D_DrawQuadGouraudShadedGeneric, M3D_DrawQuadGouraudShadedTop, M3D_DrawQuadGouraudShadedBottom, M3D_DrawQuadGouraudShadedBoth }
+  },
+  {
+    { NULL, M3D_DrawFlatTexturedTop, M3D_DrawFlatTexturedBottom, M3D_DrawFlatTexturedGeneric },
+    { M3D_DrawQuadFlatTexturedGeneric, M3D_DrawQuadFlatTexturedTop, M3D_DrawQuadFlatTexturedBottom, M3D_DrawQuadFlatTexturedBoth }
+  },
+  {
+    { NULL, M3D_DrawGouraudTexturedTop, M3D_DrawGouraudTexturedBottom, M3D_DrawGouraudTexturedGeneric },
+    { M3D_DrawQuadGouraudTexturedGeneric, M3D_DrawQuadGouraudTexturedTop, M3D_DrawQuadGouraudTexturedBottom, M3D_DrawQuadGouraudTexturedBoth }
   }
+};
+
+/** Select the span kernels of the current states, called each time the states change */
+VOID M3D_SelectKernels(M3D_Context *context)
+{
+  ULONG gouraud = (context->states & M3D_GOURAUD) ? 1 : 0;
+
+  // The texture is only known per figure, both shading modes are kept
+  context->shaded_kernels = &kernel_table[gouraud];
+  context->textured_kernels = &kernel_table[2 | gouraud];
+}
+
+/*****************************************************************************/
+/**                  DRAW SHADED TRIANGLE                                    */
+/*****************************************************************************/
+
+/** Draw a shaded triangle */
+VOID M3D_DrawShadedTriangle(M3D_Context *context, M3D_OrderedTriangle *triangle, M3D_DrawData *draw_data, ULONG type)
+{
+  // Setup Maggie registers
+  M3D_SetReg(texture, (APTR) context->flat_shading);
+  M3D_SetReg(tex_size, M3D_TEX64);
+  M3D_SetReg(color, triangle->color);
+  // Constant gradients for the whole triangle
+  draw_data->grad_const = M3D_SetupGradients(triangle->v1, triangle->v2, triangle->v3, draw_data);
+  // Render the triangle with the kernel of his type
+  ((M3D_Kernels *) context->shaded_kernels)->triangle[type](context, triangle, draw_data);
+}
+
+/*****************************************************************************/
+/**                      DRAW SHADED QUAD                                    */
+/*****************************************************************************/
+
+/** Draw a shaded quad */
+VOID M3D_DrawShadedQuad(M3D_Context *context, M3D_OrderedQuad *quad, M3D_DrawData *draw_data, ULONG type)
+{
+  // Setup Maggie registers
+  M3D_SetReg(texture, (APTR) context->flat_shading);
+  M3D_SetReg(tex_size, M3D_TEX64);
+  M3D_SetReg(color, quad->color);
+  // Constant gradients if the quad is planar
+  draw_data->grad_const = M3D_SetupQuadGradients(quad, draw_data, FALSE);
+  // Render the quad with the kernel of his type
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawShadedQuad of type %ld\n", type);)
+  ((M3D_Kernels *) context->shaded_kernels)->quad[type](context, quad, draw_data);
 }
 
 /*****************************************************************************/
@@ -484,45 +1140,37 @@ VOID M3D_DrawShadedQuad(M3D_Context *context, M3D_Quad *quad, M3D_DrawData *draw
 /*****************************************************************************/
 
 /** Draw a textured triangle */
-VOID M3D_DrawTexturedTriangle(M3D_Context *context, M3D_Triangle *triangle, M3D_DrawData *draw_data, ULONG type)
+VOID M3D_DrawTexturedTriangle(M3D_Context *context, M3D_OrderedTriangle *triangle, M3D_DrawData *draw_data, ULONG type)
 {
   // Setup Maggie registers
   if (triangle->texture->filtering == M3D_LINEAR) {
-    maggie->mode = context->mode | M3D_M_BILINEAR;
+    M3D_SetReg(mode, context->mode | M3D_M_BILINEAR);
   }
-  maggie->texture = triangle->texture->data;
-  maggie->tex_size = triangle->texture->mipsize;
+  M3D_SetReg(texture, triangle->texture->data);
+  M3D_SetReg(tex_size, triangle->texture->mipsize);
   if (context->states & M3D_BLENDING) {
-    maggie->color = triangle->color;
+    M3D_SetReg(color, triangle->color);
   } else {
-    maggie->color = 0xffffff;
+    M3D_SetReg(color, 0xffffff);
   }
   // Setup texture scale
   if (context->states & M3D_TEXCRDNORM) {
     draw_data->scale = 65536.0 * 256.0;
   } else {
-    draw_data->scale = 65536.0 * 256.0 / triangle->texture->width;
+    draw_data->scale = triangle->texture->scale;
   }
-  // Render the triangle depending on his type
-  if (type == TRI_FLATTOP) {
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawGouraudTexturedTop(context, triangle, draw_data);
-    } else {
-      M3D_DrawFlatTexturedTop(context, triangle, draw_data);
-    }
-  } else if (type == TRI_FLATBOTTOM) {
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawGouraudTexturedBottom(context, triangle, draw_data);
-    } else {
-      M3D_DrawFlatTexturedBottom(context, triangle, draw_data);
-    }
-  } else if (type == TRI_GENERIC) {
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawGouraudTexturedGeneric(context, triangle, draw_data);
-    } else {
-      M3D_DrawFlatTexturedGeneric(context, triangle, draw_data);
+  // Setup perspective correction
+  draw_data->persp_len = 0;
+  if (context->states & M3D_PERSPECTIVE) {
+    if (M3D_SetupPerspective(triangle->v1, triangle->v2, triangle->v3, draw_data)) {
+      draw_data->persp_len = context->persp_span;
+      draw_data->persp_inv = 1.0 / context->persp_span;
     }
   }
+  // Constant gradients for the whole triangle
+  draw_data->grad_const = M3D_SetupGradients(triangle->v1, triangle->v2, triangle->v3, draw_data);
+  // Render the triangle with the kernel of his type
+  ((M3D_Kernels *) context->textured_kernels)->triangle[type](context, triangle, draw_data);
 }
 
 /*****************************************************************************/
@@ -530,55 +1178,315 @@ VOID M3D_DrawTexturedTriangle(M3D_Context *context, M3D_Triangle *triangle, M3D_
 /*****************************************************************************/
 
 /** Draw a textured quad */
-VOID M3D_DrawTexturedQuad(M3D_Context *context, M3D_Quad *quad, M3D_DrawData *draw_data, ULONG type)
+VOID M3D_DrawTexturedQuad(M3D_Context *context, M3D_OrderedQuad *quad, M3D_DrawData *draw_data, ULONG type)
 {
   // Setup Maggie registers
   if (quad->texture->filtering == M3D_LINEAR) {
-    maggie->mode = context->mode | M3D_M_BILINEAR;
+    M3D_SetReg(mode, context->mode | M3D_M_BILINEAR);
   }
-  maggie->texture = quad->texture->data;
-  maggie->tex_size = quad->texture->mipsize;
+  M3D_SetReg(texture, quad->texture->data);
+  M3D_SetReg(tex_size, quad->texture->mipsize);
   if (context->states & M3D_BLENDING) {
-    maggie->color = quad->color;
+    M3D_SetReg(color, quad->color);
   } else {
-    maggie->color = 0xffffff;
+    M3D_SetReg(color, 0xffffff);
   }
   // Setup texture scale
   if (context->states & M3D_TEXCRDNORM) {
     draw_data->scale = 65536.0 * 256.0;
   } else {
-    draw_data->scale = 65536.0 * 256.0 / quad->texture->width;
+    draw_data->scale = quad->texture->scale;
   }
-  // Render the quad depending on his type
-  if (type == QUAD_FLATTOP) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawTexturedFlatTopQuad\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudTexturedTop(context, quad, draw_data);
-    } else {
-      M3D_DrawQuadFlatTexturedTop(context, quad, draw_data);
+  // Setup perspective correction
+  draw_data->persp_len = 0;
+  if (context->states & M3D_PERSPECTIVE) {
+    if (M3D_SetupPerspective(quad->v1, quad->v2, quad->v3, draw_data)
+        || M3D_SetupPerspective(quad->v1, quad->v3, quad->v4, draw_data)) {
+      draw_data->persp_len = context->persp_span;
+      draw_data->persp_inv = 1.0 / context->persp_span;
     }
-  } else if (type == QUAD_FLATBOTTOM) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawTexturedFlatBottomQuad\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudTexturedBottom(context, quad, draw_data);
-    } else {
-      M3D_DrawQuadFlatTexturedBottom(context, quad, draw_data);
+  }
+  // Constant gradients if the quad is planar
+  draw_data->grad_const = M3D_SetupQuadGradients(quad, draw_data, TRUE);
+  // Render the quad with the kernel of his type
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawTexturedQuad of type %ld\n", type);)
+  ((M3D_Kernels *) context->textured_kernels)->quad[type](context, quad, draw_data);
+}
+
+/*****************************************************************************/
+/**                  DIRTY TILES                                             */
+/*****************************************************************************/
+
+/** Allocate the dirty tiles of the bitmaps & of the Z buffer */
+LONG M3D_AllocDirtyMap(M3D_Context *context)
+{
+  M3D_DirtyMap *map;
+  UBYTE *tiles;
+  ULONG count, index;
+
+  if (context->dirty_data != NULL) {
+    return M3D_SUCCESS;
+  }
+  context->dirty_width = (context->drawregion.width + M3D_DIRTY_WIDTH - 1) / M3D_DIRTY_WIDTH;
+  context->dirty_height = (context->drawregion.height + M3D_DIRTY_HEIGHT - 1) / M3D_DIRTY_HEIGHT;
+  count = context->dirty_width * context->dirty_height;
+  map = M3D_AllocMem(sizeof(M3D_DirtyMap) + ((M3D_DIRTY_BUFFERS + 1) * count));
+  if (map == NULL) {
+    return M3D_NOMEMORY;
+  }
+  // The tiles follow the map in the same memory block
+  tiles = (UBYTE *) (map + 1);
+  for (index = 0;index < M3D_DIRTY_BUFFERS;index++) {
+    map->buffers[index].tiles = tiles;
+    tiles += count;
+  }
+  map->ztiles = tiles;
+  context->dirty_data = map;
+  // Nothing is known about the Z buffer content, the next clear is a full one
+  M3D_MarkDirtyTiles(context, map->ztiles, 0, 0, context->drawregion.width - 1, context->drawregion.height - 1);
+  M3D_SelectDirtyBuffer(context);
+  DDbug(kprintf("[MAGGIE3D] Dirty tiles allocated (%ld x %ld)\n", context->dirty_width, context->dirty_height);)
+  return M3D_SUCCESS;
+}
+
+/** Free the dirty tiles */
+VOID M3D_FreeDirtyMap(M3D_Context *context)
+{
+  if (context->dirty_data != NULL) {
+    M3D_FreeMem(context->dirty_data);
+  }
+  context->dirty_data = NULL;
+}
+
+/** Select the dirty tiles of the draw region bitmap, an unknown bitmap reuses the oldest tiles all dirty */
+VOID M3D_SelectDirtyBuffer(M3D_Context *context)
+{
+  M3D_DirtyMap *map;
+  M3D_DirtyBuffer *buffer;
+  UWORD index;
+
+  map = (M3D_DirtyMap *) context->dirty_data;
+  if (map == NULL) {
+    return;
+  }
+  for (index = 0;index < M3D_DIRTY_BUFFERS;index++) {
+    if (map->buffers[index].bitmap == context->drawregion.bitmap) {
+      map->current = &(map->buffers[index]);
+      return;
     }
-  } else if (type == QUAD_FLATBOTH) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawTexturedFlatBothQuad\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudTexturedBoth(context, quad, draw_data);
-    } else {
-      M3D_DrawQuadFlatTexturedBoth(context, quad, draw_data);
+  }
+  buffer = &(map->buffers[map->next]);
+  map->next = (map->next + 1) % M3D_DIRTY_BUFFERS;
+  buffer->bitmap = context->drawregion.bitmap;
+  M3D_MarkDirtyTiles(context, buffer->tiles, 0, 0, context->drawregion.width - 1, context->drawregion.height - 1);
+  map->current = buffer;
+  DDbug(kprintf("[MAGGIE3D] New bitmap 0x%lx for the dirty tiles\n", buffer->bitmap);)
+}
+
+/** Mark the tiles covered by a rectangle of pixels (right & bottom included) */
+VOID M3D_MarkDirtyTiles(M3D_Context *context, UBYTE *tiles, LONG left, LONG top, LONG right, LONG bottom)
+{
+  UBYTE *row;
+  LONG x, y;
+
+  left /= M3D_DIRTY_WIDTH;
+  top /= M3D_DIRTY_HEIGHT;
+  right /= M3D_DIRTY_WIDTH;
+  bottom /= M3D_DIRTY_HEIGHT;
+  if (right >= (LONG) context->dirty_width) {
+    right = context->dirty_width - 1;
+  }
+  if (bottom >= (LONG) context->dirty_height) {
+    bottom = context->dirty_height - 1;
+  }
+  for (y = top;y <= bottom;y++) {
+    row = tiles + (y * context->dirty_width);
+    for (x = left;x <= right;x++) {
+      row[x] = TRUE;
     }
-  } else if (type == QUAD_GENERIC) {
-    DDbug(kprintf("[MAGGIE3D] M3D_DrawTexturedGenericQuad\n");)
-    if (context->states & M3D_GOURAUD) {
-      M3D_DrawQuadGouraudTexturedGeneric(context, quad, draw_data);
-    } else {
-      M3D_DrawQuadFlatTexturedGeneric(context, quad, draw_data);
+  }
+}
+
+/** Mark the tiles covered by the bounding box of a figure, the Z tiles too if the figure writes the Z buffer */
+VOID M3D_MarkDirty(M3D_Context *context, M3D_DrawData *draw_data, M3D_OrderedVertex **vertices, ULONG count, BOOL zbuffer)
+{
+  M3D_DirtyMap *map;
+  FLOAT min_x, min_y, max_x, max_y;
+  ULONG index;
+
+  map = (M3D_DirtyMap *) context->dirty_data;
+  if (map == NULL) {
+    return;
+  }
+  min_x = max_x = vertices[0]->x;
+  min_y = max_y = vertices[0]->y;
+  for (index = 1;index < count;index++) {
+    if (vertices[index]->x < min_x) {
+      min_x = vertices[index]->x;
+    } else if (vertices[index]->x > max_x) {
+      max_x = vertices[index]->x;
+    }
+    if (vertices[index]->y < min_y) {
+      min_y = vertices[index]->y;
+    } else if (vertices[index]->y > max_y) {
+      max_y = vertices[index]->y;
+    }
+  }
+  // The figure is rounded later so it can reach the next pixel
+  max_x += 1.0;
+  max_y += 1.0;
+  if (min_x < draw_data->left_clip) {
+    min_x = draw_data->left_clip;
+  }
+  if (max_x >= draw_data->right_clip) {
+    max_x = draw_data->right_clip - 1.0;
+  }
+  if (min_y < draw_data->top_clip) {
+    min_y = draw_data->top_clip;
+  }
+  if (max_y >= draw_data->bottom_clip) {
+    max_y = draw_data->bottom_clip - 1.0;
+  }
+  if (min_x > max_x || min_y > max_y) {
+    return;
+  }
+  M3D_MarkDirtyTiles(context, map->current->tiles, (LONG) min_x, (LONG) min_y, (LONG) max_x, (LONG) max_y);
+  if (zbuffer && (context->mode & (M3D_M_ZBUFFER | M3D_M_INHIBZBUF)) == M3D_M_ZBUFFER) {
+    M3D_MarkDirtyTiles(context, map->ztiles, (LONG) min_x, (LONG) min_y, (LONG) max_x, (LONG) max_y);
+  }
+}
+
+/** Clear the runs of dirty tiles inside a rectangle, the tiles fully cleared are not dirty anymore */
+VOID M3D_ClearDirtyTiles(M3D_Context *context, UBYTE *tiles, APTR data, ULONG bpr, ULONG bpp, ULONG depth, M3D_Scissor *rect, ULONG color)
+{
+  UBYTE *row;
+  ULONG region, right, bottom, first, last, start, index, tile_x, tile_y, x0, x1, y0, y1;
+  BOOL full_height;
+
+  right = rect->left + rect->width;
+  bottom = rect->top + rect->height;
+  first = rect->left / M3D_DIRTY_WIDTH;
+  last = (right - 1) / M3D_DIRTY_WIDTH;
+  if (last >= context->dirty_width) {
+    last = context->dirty_width - 1;
+  }
+  for (tile_y = rect->top / M3D_DIRTY_HEIGHT;tile_y < context->dirty_height && tile_y * M3D_DIRTY_HEIGHT < bottom;tile_y++) {
+    y0 = tile_y * M3D_DIRTY_HEIGHT;
+    y1 = y0 + M3D_DIRTY_HEIGHT;
+    // A tile partly outside of the rectangle stays dirty, tiles of the screen edges are smaller
+    full_height = (y0 >= rect->top && (y1 <= bottom || bottom >= context->drawregion.height));
+    if (y0 < rect->top) {
+      y0 = rect->top;
+    }
+    if (y1 > bottom) {
+      y1 = bottom;
+    }
+    row = tiles + (tile_y * context->dirty_width);
+    for (tile_x = first;tile_x <= last;tile_x++) {
+      if (row[tile_x]) {
+        // Clear a run of dirty tiles at once
+        start = tile_x;
+        while (tile_x < last && row[tile_x + 1]) {
+          tile_x++;
+        }
+        x0 = start * M3D_DIRTY_WIDTH;
+        x1 = (tile_x + 1) * M3D_DIRTY_WIDTH;
+        if (full_height) {
+          for (index = start;index <= tile_x;index++) {
+            if (index * M3D_DIRTY_WIDTH >= rect->left && ((index + 1) * M3D_DIRTY_WIDTH <= right || right >= context->drawregion.width)) {
+              row[index] = FALSE;
+            }
+          }
+        }
+        if (x0 < rect->left) {
+          x0 = rect->left;
+        }
+        if (x1 > right) {
+          x1 = right;
+        }
+        // The clear functions need 4 pixels per line, the clean tiles around already hold the clear color
+        if (x1 - x0 < 4) {
+          x1 = (x0 + 4 < right) ? x0 + 4 : right;
+          x0 = (x1 - 4 > rect->left) ? x1 - 4 : rect->left;
+        }
+        DDbug(kprintf("[MAGGIE3D] Clear dirty tiles %ld,%ld -> %ld,%ld\n", x0, y0, x1, y1);)
+        region = (ULONG) data + (y0 * bpr) + (x0 * bpp);
+        if (depth == 16) {
+          M3D_FastClearRegion16((APTR) region, x1 - x0, y1 - y0, bpr, color);
+        } else if (depth == 24) {
+          M3D_FastClearRegion24((APTR) region, x1 - x0, y1 - y0, bpr, color);
+        } else if (depth == 32) {
+          M3D_FastClearRegion32((APTR) region, x1 - x0, y1 - y0, bpr, color);
+        }
+      }
+    }
+  }
+}
+
+/*****************************************************************************/
+/**                  RENDER A FIGURE                                         */
+/*****************************************************************************/
+
+/** Draw a triangle depending on his type, or store it in the scene */
+ULONG M3D_RenderTriangle(M3D_Context *context, M3D_Triangle *triangle, M3D_DrawData *draw_data)
+{
+  M3D_OrderedTriangle ordered;
+  ULONG type;
+
+  if (context->states & M3D_FRUSTUMCLIP) {
+    return M3D_ClipFigure(context, &(triangle->v1), 3, triangle->texture, triangle->color, draw_data) ? TRI_GENERIC : TRI_REJECTED;
+  }
+  if (context->scene) {
+    return M3D_SceneTriangle(context, triangle);
+  }
+  // Check for triangle type
+  type = M3D_CheckTriangleType(context, triangle, &ordered, draw_data);
+  if (type != TRI_REJECTED) {
+    // Z is only remapped in the ordered triangle
+    if (context->zbuffer_frames > 1) {
+      M3D_RemapZ(context, ordered.crd, 3);
+    }
+    if (M3D_HiZFigure(context, draw_data, &(ordered.v1), 3, triangle->texture)) {
+      M3D_MarkDirty(context, draw_data, &(ordered.v1), 3, TRUE);
+      if (context->states & M3D_TEXMAPPING && triangle->texture != NULL) {
+        M3D_DrawTexturedTriangle(context, &ordered, draw_data, type);
+      } else {
+        M3D_DrawShadedTriangle(context, &ordered, draw_data, type);
+      }
+    }
+  }
+  return type;
+}
+
+/** Draw a quad depending on his type, or store it in the scene */
+ULONG M3D_RenderQuad(M3D_Context *context, M3D_Quad *quad, M3D_DrawData *draw_data)
+{
+  M3D_OrderedQuad ordered;
+  ULONG type;
+
+  if (context->states & M3D_FRUSTUMCLIP) {
+    return M3D_ClipFigure(context, &(quad->v1), 4, quad->texture, quad->color, draw_data) ? QUAD_GENERIC : QUAD_REJECTED;
+  }
+  if (context->scene) {
+    return M3D_SceneQuad(context, quad);
+  }
+  // Check for quad type
+  type = M3D_CheckQuadType(context, quad, &ordered, draw_data);
+  if (type != QUAD_REJECTED) {
+    // Z is only remapped in the ordered quad
+    if (context->zbuffer_frames > 1) {
+      M3D_RemapZ(context, ordered.crd, 4);
+    }
+    if (M3D_HiZFigure(context, draw_data, &(ordered.v1), 4, quad->texture)) {
+      M3D_MarkDirty(context, draw_data, &(ordered.v1), 4, TRUE);
+      if (context->states & M3D_TEXMAPPING && quad->texture != NULL) {
+        M3D_DrawTexturedQuad(context, &ordered, draw_data, type);
+      } else {
+        M3D_DrawShadedQuad(context, &ordered, draw_data, type);
+      }
     }
   }
+  return type;
 }
 
 /*****************************************************************************/
@@ -589,37 +1497,15 @@ VOID M3D_DrawTexturedQuad(M3D_Context *context, M3D_Quad *quad, M3D_DrawData *dr
 LONG __asm __saveds LIBM3D_DrawTriangle(register __a0 M3D_Context *context, register __a1 M3D_Triangle *triangle)
 {
   M3D_DrawData draw_data;
-  M3D_Triangle tri_copy;
   ULONG type;
 
   DDbug(kprintf("[MAGGIE3D] M3D_DrawTriangle\n");)
   if (context != NULL) {
     if (context->maggie_available) {
-      maggie->mode = context->mode;
-      maggie->modulo = context->drawregion.bpp;
-      // Setup clip constants
-      draw_data.left_clip = (FLOAT) context->clipping.left;
-      draw_data.top_clip = (FLOAT) context->clipping.top;
-      draw_data.right_clip = (FLOAT) (context->clipping.left + context->clipping.width);
-      draw_data.bottom_clip = (FLOAT) (context->clipping.top + context->clipping.height);
-      // Setup constants
-      draw_data.dest_bpr = context->drawregion.bpr;
-      draw_data.dest_bpp = context->drawregion.bpp;
-      draw_data.zbuf_bpr = context->zbuffer.bpr;
-      draw_data.zbuf_bpp = context->zbuffer.bpp;
-      // If not in fast mode
-      if (!(context->states & M3D_FAST)) {
-        CopyMem(triangle, &tri_copy, sizeof(M3D_Triangle));
-        triangle = &tri_copy;
-      }
-      // Check for triangle type
-      type = M3D_CheckTriangleType(context, triangle, &draw_data);
+      M3D_SetupDrawData(context, &draw_data);
+      // Draw the triangle depending on his type
+      type = M3D_RenderTriangle(context, triangle, &draw_data);
       if (type != TRI_REJECTED) {
-        if (context->states & M3D_TEXMAPPING && triangle->texture != NULL) {
-          M3D_DrawTexturedTriangle(context, triangle, &draw_data, type);
-        } else {
-          M3D_DrawShadedTriangle(context, triangle, &draw_data, type);
-        }
         return M3D_SUCCESS;
       }
       return M3D_NOTRIANGLE;
@@ -633,41 +1519,17 @@ LONG __asm __saveds LIBM3D_DrawTriangle(register __a0 M3D_Context *context, regi
 LONG __asm __saveds LIBM3D_DrawTriangleArray(register __a0 M3D_Context *context, register __a1 M3D_Triangle *triangles, register __d0 ULONG count)
 {
   M3D_DrawData draw_data;
-  M3D_Triangle *triangle, tri_copy;
-  ULONG type;
+  M3D_Triangle *triangle;
   UWORD index;
 
   DDbug(kprintf("[MAGGIE3D] M3D_DrawTriangleArray\n");)
   if (context != NULL) {
     if (context->maggie_available) {
-      maggie->mode = context->mode;
-      maggie->modulo = context->drawregion.bpp;
-      // Setup clip constants
-      draw_data.left_clip = (FLOAT) context->clipping.left;
-      draw_data.top_clip = (FLOAT) context->clipping.top;
-      draw_data.right_clip = (FLOAT) (context->clipping.left + context->clipping.width);
-      draw_data.bottom_clip = (FLOAT) (context->clipping.top + context->clipping.height);
-      // Setup constants
-      draw_data.dest_bpr = context->drawregion.bpr;
-      draw_data.dest_bpp = context->drawregion.bpp;
-      draw_data.zbuf_bpr = context->zbuffer.bpr;
-      draw_data.zbuf_bpp = context->zbuffer.bpp;
+      M3D_SetupDrawData(context, &draw_data);
       for (index = 0;index < count;index++) {
         triangle = &(triangles[index]);
-        // If not in fast mode
-        if (!(context->states & M3D_FAST)) {
-          CopyMem(triangle, &tri_copy, sizeof(M3D_Triangle));
-          triangle = &tri_copy;
-        }
-        // Check for triangle type
-        type = M3D_CheckTriangleType(context, triangle, &draw_data);
-        if (type != TRI_REJECTED) {
-          if (context->states & M3D_TEXMAPPING && triangle->texture != NULL) {
-            M3D_DrawTexturedTriangle(context, triangle, &draw_data, type);
-          } else {
-            M3D_DrawShadedTriangle(context, triangle, &draw_data, type);
-          }
-        }
+        // Draw the triangle depending on his type
+        M3D_RenderTriangle(context, triangle, &draw_data);
       }
       return M3D_SUCCESS;
     }
@@ -680,39 +1542,158 @@ LONG __asm __saveds LIBM3D_DrawTriangleArray(register __a0 M3D_Context *context,
 LONG __asm __saveds LIBM3D_DrawTriangleList(register __a0 M3D_Context *context, register __a1 M3D_Triangle **triangles, register __d0 ULONG count)
 {
   M3D_DrawData draw_data;
-  M3D_Triangle *triangle, tri_copy;
-  ULONG type;
+  M3D_Triangle *triangle;
   UWORD index;
 
   DDbug(kprintf("[MAGGIE3D] M3D_DrawTriangleList\n");)
   if (context != NULL) {
     if (context->maggie_available) {
-      maggie->mode = context->mode;
-      maggie->modulo = context->drawregion.bpp;
-      // Setup clip constants
-      draw_data.left_clip = (FLOAT) context->clipping.left;
-      draw_data.top_clip = (FLOAT) context->clipping.top;
-      draw_data.right_clip = (FLOAT) (context->clipping.left + context->clipping.width);
-      draw_data.bottom_clip = (FLOAT) (context->clipping.top + context->clipping.height);
-      // Setup constants
-      draw_data.dest_bpr = context->drawregion.bpr;
-      draw_data.dest_bpp = context->drawregion.bpp;
-      draw_data.zbuf_bpr = context->zbuffer.bpr;
-      draw_data.zbuf_bpp = context->zbuffer.bpp;
+      M3D_SetupDrawData(context, &draw_data);
       for (index = 0;index < count;index++) {
         triangle = triangles[index];
-        // If not in fast mode
-        if (!(context->states & M3D_FAST)) {
-          CopyMem(triangle, &tri_copy, sizeof(M3D_Triangle));
-          triangle = &tri_copy;
+        // Draw the triangle depending on his type
+        M3D_RenderTriangle(context, triangle, &draw_data);
+      }
+      return M3D_SUCCESS;
+    }
+    return M3D_NOMAGGIE;
+  }
+  return M3D_NOCONTEXT;
+}
+
+/*****************************************************************************/
+/**                 DRAW INDEXED TRIANGLES                                   */
+/*****************************************************************************/
+
+/** Draw a triangle from three prepared vertices */
+VOID M3D_DrawVertexTriangle(M3D_Context *context, M3D_OrderedVertex *va, M3D_OrderedVertex *vb, M3D_OrderedVertex *vc, M3D_Texture *texture, ULONG color, M3D_DrawData *draw_data)
+{
+  M3D_Triangle triangle;
+  M3D_OrderedTriangle ordered;
+  ULONG type;
+
+  // Prepared vertices are already rounded, reject before any copy
+  if (!(context->states & M3D_FRUSTUMCLIP) && M3D_CullTriangle(context, va, vb, vc)) {
+    return;
+  }
+  // Clipped & stored figures need their own copy of the caller's vertices
+  if ((context->states & M3D_FRUSTUMCLIP) || context->scene) {
+    CopyMem(va->vertex, &(triangle.v1), sizeof(M3D_Vertex));
+    CopyMem(vb->vertex, &(triangle.v2), sizeof(M3D_Vertex));
+    CopyMem(vc->vertex, &(triangle.v3), sizeof(M3D_Vertex));
+    triangle.texture = texture;
+    triangle.color = color;
+    if (context->states & M3D_FRUSTUMCLIP) {
+      M3D_RenderTriangle(context, &triangle, draw_data);
+    } else {
+      M3D_SceneTriangle(context, &triangle);
+    }
+    return;
+  }
+  // The shared vertices are only ordered through pointers
+  ordered.v1 = va;
+  ordered.v2 = vb;
+  ordered.v3 = vc;
+  ordered.texture = texture;
+  ordered.color = color;
+  // Check for triangle type
+  type = M3D_SortTriangle(context, &ordered, draw_data);
+  if (type != TRI_REJECTED && M3D_HiZFigure(context, draw_data, &(ordered.v1), 3, texture)) {
+    M3D_MarkDirty(context, draw_data, &(ordered.v1), 3, TRUE);
+    if (context->states & M3D_TEXMAPPING && texture != NULL) {
+      M3D_DrawTexturedTriangle(context, &ordered, draw_data, type);
+    } else {
+      M3D_DrawShadedTriangle(context, &ordered, draw_data, type);
+    }
+  }
+}
+
+/** Draw triangles from an array of shared vertices & a list of indices */
+LONG __asm __saveds LIBM3D_DrawIndexedTriangles(register __a0 M3D_Context *context, register __a1 M3D_Vertex *vertices, register __a2 APTR indices, register __d0 ULONG count, register __a3 M3D_Texture *texture, register __d1 UWORD format, register __d2 ULONG color)
+{
+  M3D_DrawData draw_data;
+  M3D_OrderedVertex *buffer;
+  UWORD *indices16;
+  ULONG *indices32, nbvertices, nbindices, index, i1, i2, i3;
+  UBYTE *clip;
+
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawIndexedTriangles\n");)
+  if (context != NULL) {
+    if (context->maggie_available) {
+      if (vertices == NULL || indices == NULL) {
+        return M3D_BADPARAM;
+      }
+      indices16 = (UWORD *) indices;
+      indices32 = (ULONG *) indices;
+      nbindices = count * 3;
+      // Get the number of used vertices
+      nbvertices = 0;
+      for (index = 0;index < nbindices;index++) {
+        i1 = (format == M3D_INDEX32) ? indices32[index] : indices16[index];
+        if (i1 >= nbvertices) {
+          nbvertices = i1 + 1;
+        }
+      }
+      M3D_SetupDrawData(context, &draw_data);
+      // Round & clip each vertex only once
+      clip = M3D_PrepareVertices(context, vertices, &buffer, nbvertices, &draw_data);
+      if (clip == NULL) {
+        return M3D_NOMEMORY;
+      }
+      for (index = 0;index < nbindices;index += 3) {
+        if (format == M3D_INDEX32) {
+          i1 = indices32[index];
+          i2 = indices32[index + 1];
+          i3 = indices32[index + 2];
+        } else {
+          i1 = indices16[index];
+          i2 = indices16[index + 1];
+          i3 = indices16[index + 2];
         }
-        // Check for triangle type
-        type = M3D_CheckTriangleType(context, triangle, &draw_data);
-        if (type != TRI_REJECTED) {
-          if (context->states & M3D_TEXMAPPING && triangle->texture != NULL) {
-            M3D_DrawTexturedTriangle(context, triangle, &draw_data, type);
+        // Trivial rejection when all vertices are outside of the same clip side
+        if ((clip[i1] & clip[i2] & clip[i3]) == 0) {
+          M3D_DrawVertexTriangle(context, &(buffer[i1]), &(buffer[i2]), &(buffer[i3]), texture, color, &draw_data);
+        }
+      }
+      return M3D_SUCCESS;
+    }
+    return M3D_NOMAGGIE;
+  }
+  return M3D_NOCONTEXT;
+}
+
+/*****************************************************************************/
+/**                DRAW TRIANGLE STRIP & FAN                                 */
+/*****************************************************************************/
+
+/** Draw a strip of triangles */
+LONG __asm __saveds LIBM3D_DrawTriangleStrip(register __a0 M3D_Context *context, register __a1 M3D_Vertex *vertices, register __d0 ULONG count, register __a2 M3D_Texture *texture, register __d1 ULONG color)
+{
+  M3D_DrawData draw_data;
+  M3D_OrderedVertex *buffer;
+  ULONG index;
+  UBYTE *clip;
+
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawTriangleStrip\n");)
+  if (context != NULL) {
+    if (context->maggie_available) {
+      if (vertices == NULL || count < 3) {
+        return M3D_BADPARAM;
+      }
+      M3D_SetupDrawData(context, &draw_data);
+      // Round & clip each vertex only once
+      clip = M3D_PrepareVertices(context, vertices, &buffer, count, &draw_data);
+      if (clip == NULL) {
+        return M3D_NOMEMORY;
+      }
+      for (index = 2;index < count;index++) {
+        // Trivial rejection when all vertices are outside of the same clip side
+        if ((clip[index - 2] & clip[index - 1] & clip[index]) == 0) {
+          // Keep the same winding for all triangles
+          if (index & 1) {
+            M3D_DrawVertexTriangle(context, &(buffer[index - 1]), &(buffer[index - 2]), &(buffer[index]), texture, color, &draw_data);
           } else {
-            M3D_DrawShadedTriangle(context, triangle, &draw_data, type);
+            M3D_DrawVertexTriangle(context, &(buffer[index - 2]), &(buffer[index - 1]), &(buffer[index]), texture, color, &draw_data);
           }
         }
       }
@@ -723,6 +1704,39 @@ LONG __asm __saveds LIBM3D_DrawTriangleList(register __a0 M3D_Context *context,
   return M3D_NOCONTEXT;
 }
 
+/** Draw a fan of triangles */
+LONG __asm __saveds LIBM3D_DrawTriangleFan(register __a0 M3D_Context *context, register __a1 M3D_Vertex *vertices, register __d0 ULONG count, register __a2 M3D_Texture *texture, register __d1 ULONG color)
+{
+  M3D_DrawData draw_data;
+  M3D_OrderedVertex *buffer;
+  ULONG index;
+  UBYTE *clip;
+
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawTriangleFan\n");)
+  if (context != NULL) {
+    if (context->maggie_available) {
+      if (vertices == NULL || count < 3) {
+        return M3D_BADPARAM;
+      }
+      M3D_SetupDrawData(context, &draw_data);
+      // Round & clip each vertex only once
+      clip = M3D_PrepareVertices(context, vertices, &buffer, count, &draw_data);
+      if (clip == NULL) {
+        return M3D_NOMEMORY;
+      }
+      for (index = 2;index < count;index++) {
+        // Trivial rejection when all vertices are outside of the same clip side
+        if ((clip[0] & clip[index - 1] & clip[index]) == 0) {
+          M3D_DrawVertexTriangle(context, &(buffer[0]), &(buffer[index - 1]), &(buffer[index]), texture, color, &draw_data);
+        }
+      }
+      return M3D_SUCCESS;
+    }
+    return M3D_NOMAGGIE;
+  }
+  return M3D_NOCONTEXT;
+}
+
 /*****************************************************************************/
 /**                        DRAW A QUAD                                       */
 /*****************************************************************************/
@@ -731,37 +1745,15 @@ LONG __asm __saveds LIBM3D_DrawTriangleList(register __a0 M3D_Context *context,
 LONG __asm __saveds LIBM3D_DrawQuad(register __a0 M3D_Context *context, register __a1 M3D_Quad *quad)
 {
   M3D_DrawData draw_data;
-  M3D_Quad quad_copy;
   ULONG type;
 
   DDbug(kprintf("[MAGGIE3D] M3D_DrawQuad\n");)
   if (context != NULL) {
     if (context->maggie_available) {
-      maggie->mode = context->mode;
-      maggie->modulo = context->drawregion.bpp;
-      // Setup clip constants
-      draw_data.left_clip = (FLOAT) context->clipping.left;
-      draw_data.top_clip = (FLOAT) context->clipping.top;
-      draw_data.right_clip = (FLOAT) (context->clipping.left + context->clipping.width);
-      draw_data.bottom_clip = (FLOAT) (context->clipping.top + context->clipping.height);
-      // Setup constants
-      draw_data.dest_bpr = context->drawregion.bpr;
-      draw_data.dest_bpp = context->drawregion.bpp;
-      draw_data.zbuf_bpr = context->zbuffer.bpr;
-      draw_data.zbuf_bpp = context->zbuffer.bpp;
-      // If not in fast mode
-      if (!(context->states & M3D_FAST)) {
-        CopyMem(quad, &quad_copy, sizeof(M3D_Quad));
-        quad = &quad_copy;
-      }
-      // Check for quad type
-      type = M3D_CheckQuadType(context, quad, &draw_data);
+      M3D_SetupDrawData(context, &draw_data);
+      // Draw the quad depending on his type
+      type = M3D_RenderQuad(context, quad, &draw_data);
       if (type != QUAD_REJECTED) {
-        if (context->states & M3D_TEXMAPPING && quad->texture != NULL) {
-          M3D_DrawTexturedQuad(context, quad, &draw_data, type);
-        } else {
-          M3D_DrawShadedQuad(context, quad, &draw_data, type);
-        }
         return M3D_SUCCESS;
       }
       return M3D_NOQUAD;
@@ -771,47 +1763,108 @@ LONG __asm __saveds LIBM3D_DrawQuad(register __a0 M3D_Context *context, register
   return M3D_NOCONTEXT;
 }
 
+/** Draw an array of quads */
+LONG __asm __saveds LIBM3D_DrawQuadArray(register __a0 M3D_Context *context, register __a1 M3D_Quad *quads, register __d0 ULONG count)
+{
+  M3D_DrawData draw_data;
+  M3D_Quad *quad;
+  ULONG index;
+
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawQuadArray\n");)
+  if (context != NULL) {
+    if (context->maggie_available) {
+      M3D_SetupDrawData(context, &draw_data);
+      for (index = 0;index < count;index++) {
+        quad = &(quads[index]);
+        // Draw the quad depending on his type
+        M3D_RenderQuad(context, quad, &draw_data);
+      }
+      return M3D_SUCCESS;
+    }
+    return M3D_NOMAGGIE;
+  }
+  return M3D_NOCONTEXT;
+}
+
+/** Draw a list of quads */
+LONG __asm __saveds LIBM3D_DrawQuadList(register __a0 M3D_Context *context, register __a1 M3D_Quad **quads, register __d0 ULONG count)
+{
+  M3D_DrawData draw_data;
+  M3D_Quad *quad;
+  ULONG index;
+
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawQuadList\n");)
+  if (context != NULL) {
+    if (context->maggie_available) {
+      M3D_SetupDrawData(context, &draw_data);
+      for (index = 0;index < count;index++) {
+        quad = quads[index];
+        // Draw the quad depending on his type
+        M3D_RenderQuad(context, quad, &draw_data);
+      }
+      return M3D_SUCCESS;
+    }
+    return M3D_NOMAGGIE;
+  }
+  return M3D_NOCONTEXT;
+}
+
 /*****************************************************************************/
 /**                       DRAW A SPRITE                                      */
 /*****************************************************************************/
 
-/** Draw a normal sprite */
-LONG M3D_DrawNormalSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, LONG ypos)
+/** Check if a sprite is inside the clipping region */
+BOOL M3D_SpriteVisible(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, LONG ypos)
 {
-  FLOAT scale, ui, vi, du, dv;
-  LONG clip_left, clip_top, clip_right, clip_bottom, dx, dy;
-  ULONG dest;
+  LONG dx, dy;
 
-  clip_left = context->clipping.left;
-  clip_top = context->clipping.top;
-  clip_right = context->clipping.left + context->clipping.width;
-  clip_bottom = context->clipping.top + context->clipping.height;
-  DDbug(kprintf("[MAGGIE3D] Sprite clipping %ld,%ld -> %ld,%ld\n", clip_left, clip_top, clip_right, clip_bottom);)
   // Apply zoom factor
   dx = sprite->width * sprite->x_zoom;
   dy = sprite->height * sprite->y_zoom;
-  // Check if sprite is in the clipping region
-  if (xpos >= clip_right || ypos >= clip_bottom || (xpos + dx) < clip_left || (ypos + dy) < clip_top) {
+  if (xpos >= (LONG) (context->clipping.left + context->clipping.width) || ypos >= (LONG) (context->clipping.top + context->clipping.height)
+      || (xpos + dx) < (LONG) context->clipping.left || (ypos + dy) < (LONG) context->clipping.top) {
     DDbug(kprintf("[MAGGIE3D] Sprite out of clipping region\n");)
-    return M3D_SUCCESS;
+    return FALSE;
   }
-  // Setup Maggie registers
+  return TRUE;
+}
+
+/** Setup the Maggie registers for a sprite */
+VOID M3D_SetupSpriteRegisters(M3D_Context *context, M3D_Sprite *sprite)
+{
+  // Sprites are never queued, draw the pending spans first
+  M3D_FlushSpans();
   if (sprite->texture->filtering == M3D_LINEAR) {
-    maggie->mode = (context->mode | M3D_M_BILINEAR) & ~M3D_M_ZBUFFER;
+    M3D_SetReg(mode, (context->mode | M3D_M_BILINEAR) & ~M3D_M_ZBUFFER);
   } else {
-    maggie->mode = context->mode & ~M3D_M_ZBUFFER;
+    M3D_SetReg(mode, context->mode & ~M3D_M_ZBUFFER);
   }
-  maggie->modulo = context->drawregion.bpp;
-  maggie->texture = sprite->texture->data;
-  maggie->tex_size = sprite->texture->mipsize;
-  maggie->color = sprite->color;
+  M3D_SetReg(modulo, context->drawregion.bpp);
+  M3D_SetReg(texture, sprite->texture->data);
+  M3D_SetReg(tex_size, sprite->texture->mipsize);
+  M3D_SetReg(color, sprite->color);
   maggie->light_start = (UFIXED) (sprite->light * 65535.0);
-  maggie->light_delta = 0;
+  M3D_SetReg(light_delta, 0);
   maggie->z_start = 0;
-  maggie->z_delta = 0;
+  M3D_SetReg(z_delta, 0);
   maggie->zbuffer = NULL;
-  // Texture scaling
-  scale = 65536.0 * 256.0 / sprite->texture->width;
+}
+
+/** Render the lines of a normal sprite with the current Maggie registers */
+VOID M3D_RenderNormalSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, LONG ypos, FLOAT scale)
+{
+  FLOAT ui, vi, du, dv;
+  LONG clip_left, clip_top, clip_right, clip_bottom, dx, dy;
+  ULONG dest;
+
+  clip_left = context->clipping.left;
+  clip_top = context->clipping.top;
+  clip_right = context->clipping.left + context->clipping.width;
+  clip_bottom = context->clipping.top + context->clipping.height;
+  DDbug(kprintf("[MAGGIE3D] Sprite clipping %ld,%ld -> %ld,%ld\n", clip_left, clip_top, clip_right, clip_bottom);)
+  // Apply zoom factor
+  dx = sprite->width * sprite->x_zoom;
+  dy = sprite->height * sprite->y_zoom;
   // Manage sprite flipping
   if (sprite->x_flip) {
     ui = (FLOAT)(sprite->left + sprite->width);
@@ -844,6 +1897,9 @@ LONG M3D_DrawNormalSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, L
   if ((ypos + dy) >= clip_bottom) {
     dy = clip_bottom - ypos;
   }
+  if (context->dirty_data != NULL && dx > 0 && dy > 0) {
+    M3D_MarkDirtyTiles(context, ((M3D_DirtyMap *) context->dirty_data)->current->tiles, xpos, ypos, xpos + dx - 1, ypos + dy - 1);
+  }
   // Destination address
   dest = (ULONG)context->drawregion.data + (context->drawregion.bpr * ypos) + (xpos * context->drawregion.bpp);
   // Draw the sprite
@@ -851,8 +1907,8 @@ LONG M3D_DrawNormalSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, L
     maggie->destination = (APTR) dest;
     maggie->u_start = (LFIXED) (ui * scale);
     maggie->v_start = (LFIXED) (vi * scale);
-    maggie->u_delta = (LFIXED) (du * scale);
-    maggie->v_delta = 0;
+    M3D_SetReg(u_delta, (LFIXED) (du * scale));
+    M3D_SetReg(v_delta, 0);
     WaitBlit();
     maggie->start_length = dx;
 #if _USE_MAGGIE_ == 0
@@ -861,6 +1917,16 @@ LONG M3D_DrawNormalSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, L
     vi += dv;
     dest += context->drawregion.bpr;
   }
+}
+
+/** Draw a sprite without rotation */
+LONG M3D_DrawNormalSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, LONG ypos)
+{
+  // Check if sprite is in the clipping region
+  if (M3D_SpriteVisible(context, sprite, xpos, ypos)) {
+    M3D_SetupSpriteRegisters(context, sprite);
+    M3D_RenderNormalSprite(context, sprite, xpos, ypos, sprite->texture->scale);
+  }
   return M3D_SUCCESS;
 }
 
@@ -896,7 +1962,9 @@ LONG M3D_DrawRotatedSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos,
 {
   M3D_DrawData draw_data;
   M3D_Quad quad;
+  M3D_OrderedQuad ordered;
   ULONG type, dx, dy;
+  WORDBITS states;
 
   // Setup clip constants
   draw_data.left_clip = (FLOAT) context->clipping.left;
@@ -911,6 +1979,10 @@ LONG M3D_DrawRotatedSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos,
   draw_data.dest_bpp = context->drawregion.bpp;
   draw_data.zbuf_bpr = context->zbuffer.bpr;
   draw_data.zbuf_bpp = context->zbuffer.bpp;
+  draw_data.span_queue = (context->states & M3D_SPANQUEUE) ? TRUE : FALSE;
+  draw_data.bins = NULL;
+  // Sprites do not use the Z buffer
+  draw_data.hiz = NULL;
   // Setup quad with sprite info
   quad.v1.x = xpos;
   quad.v1.y = ypos;
@@ -970,36 +2042,41 @@ LONG M3D_DrawRotatedSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos,
     quad.v4.u = sprite->left;
     quad.v4.v = sprite->top + sprite->height;
   }
-  DDbug(M3D_DumpQuad(&quad);)
-  // Check for quad type
-  type = M3D_CheckQuadType(context, &quad, &draw_data);
+  // Check for quad type, sprites are never culled
+  states = context->states;
+  context->states &= ~(M3D_CULLBACK | M3D_CULLFRONT);
+  type = M3D_CheckQuadType(context, &quad, &ordered, &draw_data);
+  context->states = states;
   if (type != QUAD_REJECTED) {
+    M3D_MarkDirty(context, &draw_data, &(ordered.v1), 4, FALSE);
     // Setup Maggie registers
     if (sprite->texture->filtering == M3D_LINEAR) {
-      maggie->mode = (context->mode | M3D_M_BILINEAR) & ~M3D_M_ZBUFFER;
+      M3D_SetReg(mode, (context->mode | M3D_M_BILINEAR) & ~M3D_M_ZBUFFER);
     } else {
-      maggie->mode = context->mode & ~M3D_M_ZBUFFER;
+      M3D_SetReg(mode, context->mode & ~M3D_M_ZBUFFER);
     }
-    maggie->modulo = context->drawregion.bpp;
-    maggie->texture = sprite->texture->data;
-    maggie->tex_size = sprite->texture->mipsize;
-    maggie->color = sprite->color;
+    M3D_SetReg(modulo, context->drawregion.bpp);
+    M3D_SetReg(texture, sprite->texture->data);
+    M3D_SetReg(tex_size, sprite->texture->mipsize);
+    M3D_SetReg(color, sprite->color);
     maggie->light_start = (UFIXED) (sprite->light * 65535.0);
-    maggie->light_delta = 0;
+    M3D_SetReg(light_delta, 0);
     maggie->z_start = 0;
-    maggie->z_delta = 0;
+    M3D_SetReg(z_delta, 0);
     maggie->zbuffer = NULL;
     // Setup texture scale
-    draw_data.scale = 65536.0 * 256.0 / sprite->texture->width;
+    draw_data.scale = sprite->texture->scale;
+    draw_data.persp_len = 0;
+    draw_data.grad_const = M3D_SetupQuadGradients(&ordered, &draw_data, TRUE);
     // Render the quad depending on his type
     if (type == QUAD_FLATTOP) {
-      M3D_DrawQuadFlatTexturedTop(context, &quad, &draw_data);
+      M3D_DrawQuadFlatTexturedTop(context, &ordered, &draw_data);
     } else if (type == QUAD_FLATBOTTOM) {
-      M3D_DrawQuadFlatTexturedBottom(context, &quad, &draw_data);
+      M3D_DrawQuadFlatTexturedBottom(context, &ordered, &draw_data);
     } else if (type == QUAD_FLATBOTH) {
-      M3D_DrawQuadFlatTexturedBoth(context, &quad, &draw_data);
+      M3D_DrawQuadFlatTexturedBoth(context, &ordered, &draw_data);
     } else if (type == QUAD_GENERIC) {
-      M3D_DrawQuadFlatTexturedGeneric(context, &quad, &draw_data);
+      M3D_DrawQuadFlatTexturedGeneric(context, &ordered, &draw_data);
     }
     return M3D_SUCCESS;
   }
@@ -1013,6 +2090,11 @@ LONG __asm __saveds LIBM3D_DrawSprite(register __a0 M3D_Context *context, regist
   DDbug(M3D_DumpSprite(sprite);)
   if (context != NULL) {
     if (context->maggie_available) {
+      if (context->scene) {
+        return M3D_SceneSprite(context, sprite, xpos, ypos);
+      }
+      // Sprites are not binned, draw the pending figures below them
+      M3D_FlushBins(context);
       if (sprite->angle == 0.0) {
         return M3D_DrawNormalSprite(context, sprite, xpos, ypos);
       } else {
@@ -1024,6 +2106,129 @@ LONG __asm __saveds LIBM3D_DrawSprite(register __a0 M3D_Context *context, regist
   return M3D_NOCONTEXT;
 }
 
+/** Draw an array of sprites, registers are only updated when they change between two sprites */
+LONG __asm __saveds LIBM3D_DrawSpriteArray(register __a0 M3D_Context *context, register __a1 M3D_Sprite *sprites, register __a2 M3D_Position *positions, register __d0 ULONG count)
+{
+  M3D_Sprite *sprite, *last;
+  FLOAT scale;
+  ULONG index;
+
+  DDbug(kprintf("[MAGGIE3D] M3D_DrawSpriteArray of %ld sprites\n", count);)
+  if (context != NULL) {
+    if (context->maggie_available) {
+      if (context->scene) {
+        for (index = 0; index < count; index++) {
+          M3D_SceneSprite(context, &sprites[index], positions[index].x, positions[index].y);
+        }
+        return M3D_SUCCESS;
+      }
+      M3D_FlushBins(context);
+      last = NULL;
+      scale = 0.0;
+      for (index = 0; index < count; index++) {
+        sprite = &sprites[index];
+        if (sprite->angle != 0.0) {
+          // Rotated sprites are drawn as quads and change all the registers
+          M3D_DrawRotatedSprite(context, sprite, positions[index].x, positions[index].y);
+          last = NULL;
+          continue;
+        }
+        if (!M3D_SpriteVisible(context, sprite, positions[index].x, positions[index].y)) {
+          continue;
+        }
+        if (last == NULL) {
+          M3D_SetupSpriteRegisters(context, sprite);
+          scale = sprite->texture->scale;
+        } else {
+          if (sprite->texture != last->texture) {
+            if (sprite->texture->filtering == M3D_LINEAR) {
+              M3D_SetReg(mode, (context->mode | M3D_M_BILINEAR) & ~M3D_M_ZBUFFER);
+            } else {
+              M3D_SetReg(mode, context->mode & ~M3D_M_ZBUFFER);
+            }
+            M3D_SetReg(texture, sprite->texture->data);
+            M3D_SetReg(tex_size, sprite->texture->mipsize);
+            scale = sprite->texture->scale;
+          }
+          if (sprite->color != last->color) {
+            M3D_SetReg(color, sprite->color);
+          }
+          if (sprite->light != last->light) {
+            maggie->light_start = (UFIXED) (sprite->light * 65535.0);
+          }
+        }
+        M3D_RenderNormalSprite(context, sprite, positions[index].x, positions[index].y, scale);
+        last = sprite;
+      }
+      return M3D_SUCCESS;
+    }
+    return M3D_NOMAGGIE;
+  }
+  return M3D_NOCONTEXT;
+}
+
+/** Write the shadow registers to Maggie, another task may have used it since the last lock */
+VOID M3D_SyncShadowRegs(VOID)
+{
+  WaitBlit();
+  maggie->texture = maggie_shadow.texture;
+  maggie->tex_size = maggie_shadow.tex_size;
+  maggie->mode = maggie_shadow.mode;
+  maggie->modulo = maggie_shadow.modulo;
+  maggie->u_delta = maggie_shadow.u_delta;
+  maggie->v_delta = maggie_shadow.v_delta;
+  maggie->light_delta = maggie_shadow.light_delta;
+  maggie->color = maggie_shadow.color;
+  maggie->z_delta = maggie_shadow.z_delta;
+}
+
+/** Get the next free span of the queue, the queue is flushed when full */
+M3D_SpanCmd *M3D_NextSpan(VOID)
+{
+  if (span_count == M3D_SPANQUEUE_SIZE) {
+    M3D_FlushSpans();
+  }
+  return &span_queue[span_count++];
+}
+
+/** Feed Maggie with all the queued spans */
+VOID M3D_FlushSpans(VOID)
+{
+  UWORD count;
+#if _USE_MAGGIE_ == 0
+  M3D_SpanCmd *span;
+  UWORD index;
+#endif
+
+  if (span_count == 0) {
+    return;
+  }
+  DDbug(kprintf("[MAGGIE3D] Flushing %ld queued spans\n", (ULONG) span_count);)
+  // Empty the queue first, the register writes below must not flush it again
+  count = span_count;
+  span_count = 0;
+#if _USE_MAGGIE_ == 1
+  M3D_FastFeedSpans(span_queue, count, &maggie_shadow, maggie);
+#else
+  for (index = 0; index < count; index++) {
+    span = &span_queue[index];
+    maggie->destination = span->destination;
+    maggie->zbuffer = span->zbuffer;
+    maggie->u_start = span->u_start;
+    maggie->v_start = span->v_start;
+    M3D_SetReg(u_delta, span->u_delta);
+    M3D_SetReg(v_delta, span->v_delta);
+    maggie->light_start = span->light_start;
+    M3D_SetReg(light_delta, span->light_delta);
+    maggie->z_start = span->z_start;
+    M3D_SetReg(z_delta, span->z_delta);
+    WaitBlit();
+    maggie->start_length = span->length;
+    M3D_EmulateMaggie();
+  }
+#endif
+}
+
 /** Return the physical bitmap address */
 ULONG M3D_GetBitmapAddress(struct BitMap *bitmap)
 {
@@ -1048,6 +2253,7 @@ LONG __asm __saveds LIBM3D_LockHardware(register __a0 M3D_Context *context)
       context->drawregion.data = (APTR) M3D_GetBitmapAddress(context->drawregion.bitmap);
       DDbug(kprintf("[MAGGIE3D] Hardware locked with buffer address 0x%lx \n", context->drawregion.data);)
       OwnBlitter();
+      M3D_SyncShadowRegs();
       return M3D_SUCCESS;
     }
     return M3D_NOBITMAP;
@@ -1059,6 +2265,8 @@ LONG __asm __saveds LIBM3D_LockHardware(register __a0 M3D_Context *context)
 VOID __asm __saveds LIBM3D_UnlockHardware(register __a0 M3D_Context *context)
 {
   if (context != NULL) {
+    M3D_FlushBins(context);
+    M3D_FlushSpans();
     DisownBlitter();
     DDbug(kprintf("[MAGGIE3D] Hardware unlocked\n");)
   }
@@ -1067,10 +2275,23 @@ VOID __asm __saveds LIBM3D_UnlockHardware(register __a0 M3D_Context *context)
 /** Clear the draw region with specified color */
 LONG __asm __saveds LIBM3D_ClearDrawRegion(register __a0 M3D_Context *context, register __d0 ULONG color)
 {
+  M3D_DirtyMap *map;
   ULONG region;
 
   if (context != NULL) {
     if (context->drawregion.data != NULL) {
+      M3D_FlushBins(context);
+      M3D_FlushSpans();
+      map = (M3D_DirtyMap *) context->dirty_data;
+      if (map != NULL) {
+        // The clean tiles hold the previous clear color
+        if (color != map->current->color) {
+          M3D_MarkDirtyTiles(context, map->current->tiles, 0, 0, context->drawregion.width - 1, context->drawregion.height - 1);
+          map->current->color = color;
+        }
+        M3D_ClearDirtyTiles(context, map->current->tiles, context->drawregion.data, context->drawregion.bpr, context->drawregion.bpp, context->drawregion.depth, &(context->clipping), color);
+        return M3D_SUCCESS;
+      }
       region = (ULONG) context->drawregion.data;
       region += (context->clipping.left * context->drawregion.bpp) + (context->clipping.top * context->drawregion.bpr);
       DDbug(kprintf("[MAGGIE3D] Clear region %ld,%ld -> %ld,%ld (%ld)\n",
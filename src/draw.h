@@ -47,6 +47,52 @@ typedef struct
   LFIXED z_delta;       /* $DFF28C 32bit Delta (16:16 fixed) */
 } M3D_MaggieRegs;
 
+// Queued span, the registers written for each span
+typedef struct {
+  APTR destination;
+  APTR zbuffer;
+  LFIXED u_start, v_start;
+  LFIXED u_delta, v_delta;
+  UFIXED light_start;
+  SFIXED light_delta;
+  LFIXED z_start, z_delta;
+  UWORD length, pad;
+} M3D_SpanCmd;
+
+// Number of spans in the queue
+#define M3D_SPANQUEUE_SIZE  256
+
+// Write a Maggie register only if its value differs from the shadow copy, queued spans are drawn before the change
+#define M3D_SetReg(reg, value) do { if (maggie_shadow.reg != (value)) { if (span_count) { M3D_FlushSpans(); } maggie_shadow.reg = (value); maggie->reg = maggie_shadow.reg; } } while (0)
+
+// Next queued span of a figure, recorded in the tile bins or queued for Maggie
+#define M3D_FigureSpan(draw_data) (((draw_data)->bins != NULL) ? M3D_NextBinSpan((draw_data)->bins) : M3D_NextSpan())
+
+// Draw the span started on Maggie with the emulation, an untextured span has no texture
+#if _USE_MAGGIE_ == 0
+#define M3D_EmulateSpan(textured) do { if (!(textured)) { M3D_SetReg(texture, NULL); } M3D_EmulateMaggie(); } while (0)
+#else
+#define M3D_EmulateSpan(textured)
+#endif
+
+// Hierarchical Z buffer tile size & all lines of a tile covered
+#define HIZ_WIDTH           32
+#define HIZ_HEIGHT          8
+#define HIZ_ROWS            0xff
+
+// Hierarchical Z buffer tile, max is above all Z values of the tile, pending is above all Z values of the covered lines
+typedef struct {
+  UWORD max, pending;
+  UBYTE rows, pad;
+} M3D_HiZTile;
+
+// Light unit of the fixed point edge walker (UFIXED with 8 more fraction bits)
+#define FIXED_LIGHT         (65535.0 * 256.0)
+
+// Range of the 16:16 fixed point edge walker, figures beyond are walked with floats
+#define FIXED_MAX           32767.0
+#define FIXED_FITS(x)       ((x) > -FIXED_MAX && (x) < FIXED_MAX)
+
 // Texture mapping data
 typedef struct {
   // Clipping
@@ -65,14 +111,80 @@ typedef struct {
   ULONG dest_adr, dest_bpr, dest_bpp;
   // Zbuf start adr
   ULONG zbuf_adr, zbuf_bpr, zbuf_bpp;
+  // Current line Y coordinate
+  FLOAT crd_y;
+  // Perspective planes for 1/W, U/W & V/W
+  FLOAT pln_w, pln_dwdx, pln_dwdy;
+  FLOAT pln_u, pln_dudx, pln_dudy;
+  FLOAT pln_v, pln_dvdx, pln_dvdy;
+  // Perspective span length (0 = affine mapping) and its inverse
+  UWORD persp_len;
+  FLOAT persp_inv;
+  // Constant gradients of Z, U, V & L over the figure
+  FLOAT grad_dzdx, grad_dudx, grad_dvdx, grad_dldx;
+  FLOAT grad_dzdy, grad_dudy, grad_dvdy, grad_dldy;
+  BOOL grad_const;
+  // Queue the spans instead of starting them immediately
+  BOOL span_queue;
+  // Context recording the queued spans in its tile bins (NULL if not binned)
+  M3D_Context *bins;
+  // Hierarchical Z buffer (NULL if Z buffer is not tested) & tiles per line
+  M3D_HiZTile *hiz;
+  ULONG hiz_width;
+  // Spans write Z on all their pixels & can update the hierarchical Z buffer
+  BOOL hiz_update;
+  // Figure inside the horizontal clipping, the spans are not clipped
+  BOOL inside;
 } M3D_DrawData;
 
+// Vertex of an ordered figure, rounded X & Y & remapped Z, the other attributes are read in the passed vertex
+typedef struct {
+  FLOAT x, y, z;
+  M3D_Vertex *vertex;
+} M3D_OrderedVertex;
+
+// Triangle & quad with their vertices ordered through pointers, the vertices are never moved
+typedef struct {
+  M3D_OrderedVertex *v1, *v2, *v3;
+  M3D_Texture *texture;
+  ULONG color;
+  M3D_OrderedVertex crd[3];
+} M3D_OrderedTriangle;
+
+typedef struct {
+  M3D_OrderedVertex *v1, *v2, *v3, *v4;
+  M3D_Texture *texture;
+  ULONG color;
+  M3D_OrderedVertex crd[4];
+} M3D_OrderedQuad;
+
+// Span kernels drawing an ordered figure of a given type
+typedef VOID (*M3D_TriangleKernel)(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+typedef VOID (*M3D_QuadKernel)(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+
+// Span kernels of a shading mode indexed by the figure type
+typedef struct {
+  M3D_TriangleKernel triangle[4];
+  M3D_QuadKernel quad[4];
+} M3D_Kernels;
+
 // Triangle type
 #define TRI_REJECTED          0
 #define TRI_FLATTOP           1
 #define TRI_FLATBOTTOM        2
 #define TRI_GENERIC           3
 
+// Vertex clipping codes
+#define CLIP_LEFT             1
+#define CLIP_RIGHT            2
+#define CLIP_TOP              4
+#define CLIP_BOTTOM           8
+#define CLIP_NEAR             16
+#define CLIP_FAR              32
+
+// Maximum vertex count of a figure clipped against the six frustum planes
+#define M3D_CLIP_VERTICES     10
+
 // Quad type
 #define QUAD_GENERIC          0
 #define QUAD_FLATTOP          1
@@ -80,7 +192,97 @@ typedef struct {
 #define QUAD_FLATBOTH         3
 #define QUAD_REJECTED         4
 
+// Tile binning
+#define M3D_TILE_WIDTH        64
+#define M3D_TILE_HEIGHT       32
+#define M3D_PRIM_BLOCK        256
+#define M3D_BIN_BLOCK         1024
+#define M3D_BIN_END           0xffffffff
+
+// Binned span with the figure registers, its position & the next span of its tile row
+typedef struct {
+  M3D_SpanCmd cmd;
+  APTR texture;
+  ULONG color;
+  UWORD tex_size, mode, modulo;
+  UWORD x, y;
+  ULONG next;
+} M3D_BinSpan;
+
+// Binned figure types
+#define PRIM_TRIANGLE         0
+#define PRIM_QUAD             1
+#define PRIM_SPRITE           2
+
+// Scene figure with its drawing states & depth sort key
+typedef struct {
+  UWORD type;
+  WORDBITS states, mode;
+  ULONG depth;
+  union {
+    M3D_Triangle triangle;
+    M3D_Quad quad;
+    struct {
+      M3D_Sprite sprite;
+      M3D_Position position;
+    } sprite;
+  } figure;
+} M3D_Primitive;
+
+// Scene figure index & its depth sort key
+typedef struct {
+  ULONG key, index;
+} M3D_SortKey;
+
+// Dirty tile size & number of bitmaps tracked for double or triple buffering
+#define M3D_DIRTY_WIDTH       32
+#define M3D_DIRTY_HEIGHT      16
+#define M3D_DIRTY_BUFFERS     3
+
+// Dirty tiles of a bitmap, a tile is TRUE if it was drawn since the last clear
+typedef struct {
+  struct BitMap *bitmap;
+  ULONG color;
+  UBYTE *tiles;
+} M3D_DirtyBuffer;
+
+// Dirty tiles of the bitmaps & of the Z buffer
+typedef struct {
+  M3D_DirtyBuffer buffers[M3D_DIRTY_BUFFERS];
+  M3D_DirtyBuffer *current;
+  UBYTE *ztiles;
+  UWORD next;
+} M3D_DirtyMap;
+
 #if _USE_MAGGIE_ == 0
+// Emulated span, the Maggie registers read once per span
+typedef struct {
+  UBYTE *destination, *texture;
+  UWORD *zbuffer;
+  LFIXED u_start, v_start, z_start;
+  LFIXED u_delta, v_delta, z_delta;
+  UFIXED light_start;
+  SFIXED light_delta;
+  ULONG red, green, blue, color;
+  ULONG block_shift, tex_scale, tex_mask, filter_scale;
+  UWORD modulo, count;
+} M3D_EmulatedSpan;
+
+// Emulated span kernel of a Maggie mode
+typedef VOID (*M3D_EmulateKernel)(M3D_EmulatedSpan *);
+
+// Number of decoded DXT1 blocks kept by the emulator
+#define M3D_BLOCK_CACHE       64
+
+// Decoded DXT1 block, the texels of the block from the top left one
+typedef struct {
+  UBYTE *block;
+  ULONG texels[16];
+} M3D_DecodedBlock;
+
+VOID M3D_FlushBlockCache(VOID);
+ULONG M3D_EmulateDXT1(M3D_EmulatedSpan *, ULONG, ULONG);
+ULONG M3D_EmulateBilinear(M3D_EmulatedSpan *, LFIXED, LFIXED);
 VOID M3D_EmulateMaggie(VOID);
 #endif
 
@@ -90,62 +292,169 @@ extern VOID __asm M3D_FastEmulateMaggie(
 );
 #endif
 
+// Quad planarity tolerances (Z unit, light unit & Maggie texture unit)
+#define PLANE_Z_EPSILON       0.5
+#define PLANE_L_EPSILON       (1.0 / 256.0)
+#define PLANE_UV_EPSILON      4096.0
+
+/**
+ * Shadow registers
+ */
+VOID M3D_SyncShadowRegs(VOID);
+
+/**
+ * Span queue
+ */
+M3D_SpanCmd *M3D_NextSpan(VOID);
+VOID M3D_FlushSpans(VOID);
+
+/**
+ * Z buffer depth bands & hierarchical Z buffer
+ */
+VOID M3D_SetZBand(M3D_Context *);
+VOID M3D_RemapZ(M3D_Context *, M3D_OrderedVertex *, ULONG);
+VOID M3D_ClearHiZ(M3D_Context *);
+BOOL M3D_HiZFigure(M3D_Context *, M3D_DrawData *, M3D_OrderedVertex **, ULONG, M3D_Texture *);
+BOOL M3D_HiZSpan(M3D_DrawData *, ULONG, LONG, LONG, LFIXED, LFIXED);
+
+/**
+ * Dirty tiles
+ */
+LONG M3D_AllocDirtyMap(M3D_Context *);
+VOID M3D_FreeDirtyMap(M3D_Context *);
+VOID M3D_SelectDirtyBuffer(M3D_Context *);
+VOID M3D_MarkDirtyTiles(M3D_Context *, UBYTE *, LONG, LONG, LONG, LONG);
+VOID M3D_MarkDirty(M3D_Context *, M3D_DrawData *, M3D_OrderedVertex **, ULONG, BOOL);
+VOID M3D_ClearDirtyTiles(M3D_Context *, UBYTE *, APTR, ULONG, ULONG, ULONG, M3D_Scissor *, ULONG);
+
+/**
+ * Tile binning
+ */
+M3D_SpanCmd *M3D_NextBinSpan(M3D_Context *);
+VOID M3D_DrawBinSpan(M3D_Context *, M3D_BinSpan *, ULONG, ULONG);
+VOID M3D_FlushBins(M3D_Context *);
+
+/**
+ * Depth sorted scene
+ */
+ULONG M3D_SceneTriangle(M3D_Context *, M3D_Triangle *);
+ULONG M3D_SceneQuad(M3D_Context *, M3D_Quad *);
+VOID M3D_DrawPrimitive(M3D_Context *, M3D_Primitive *);
+ULONG M3D_DepthKey(FLOAT);
+LONG M3D_SceneSprite(M3D_Context *, M3D_Sprite *, LONG, LONG);
+M3D_SortKey *M3D_RadixSort(M3D_SortKey *, M3D_SortKey *, ULONG);
+M3D_Texture *M3D_PrimitiveTexture(M3D_Primitive *);
+BOOL M3D_FrontToBack(M3D_Primitive *);
+M3D_SortKey *M3D_SortStates(M3D_Primitive *, M3D_SortKey *, M3D_SortKey *, ULONG);
+VOID M3D_FlushScene(M3D_Context *);
+
+/**
+ * Frustum clipping
+ */
+UBYTE M3D_FrustumCode(M3D_Vertex *);
+FLOAT M3D_PlaneDistance(M3D_Vertex *, UBYTE);
+VOID M3D_LerpVertex(M3D_Vertex *, M3D_Vertex *, FLOAT, M3D_Vertex *);
+ULONG M3D_ClipPolygon(M3D_Vertex *, ULONG, M3D_Vertex *, UBYTE);
+VOID M3D_ProjectVertex(M3D_Vertex *, M3D_DrawData *);
+BOOL M3D_ClipFigure(M3D_Context *, M3D_Vertex *, ULONG, M3D_Texture *, ULONG, M3D_DrawData *);
+
+/**
+ * Span kernels
+ */
+VOID M3D_SelectKernels(M3D_Context *);
+
+/**
+ * Figure setup
+ */
+FLOAT M3D_TriangleArea(M3D_OrderedVertex *, M3D_OrderedVertex *, M3D_OrderedVertex *);
+BOOL M3D_CullTriangle(M3D_Context *, M3D_OrderedVertex *, M3D_OrderedVertex *, M3D_OrderedVertex *);
+BOOL M3D_CullQuad(M3D_Context *, M3D_OrderedVertex *);
+VOID M3D_SwapVertex(M3D_OrderedVertex **, M3D_OrderedVertex **);
+ULONG M3D_CheckTriangleType(M3D_Context *, M3D_Triangle *, M3D_OrderedTriangle *, M3D_DrawData *);
+ULONG M3D_SortTriangle(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_CheckInside(M3D_OrderedVertex **, ULONG, M3D_DrawData *);
+ULONG M3D_CheckQuadType(M3D_Context *, M3D_Quad *, M3D_OrderedQuad *, M3D_DrawData *);
+ULONG M3D_RenderTriangle(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
+ULONG M3D_RenderQuad(M3D_Context *, M3D_Quad *, M3D_DrawData *);
+VOID M3D_SetupDrawData(M3D_Context *, M3D_DrawData *);
+UBYTE *M3D_PrepareVertices(M3D_Context *, M3D_Vertex *, M3D_OrderedVertex **, ULONG, M3D_DrawData *);
+BOOL M3D_SetupGradients(M3D_OrderedVertex *, M3D_OrderedVertex *, M3D_OrderedVertex *, M3D_DrawData *);
+BOOL M3D_SetupQuadGradients(M3D_OrderedQuad *, M3D_DrawData *, BOOL);
+BOOL M3D_FixedEdges(UWORD, M3D_DrawData *);
+
+/**
+ * Sprites
+ */
+LONG M3D_DrawNormalSprite(M3D_Context *, M3D_Sprite *, LONG, LONG);
+LONG M3D_DrawRotatedSprite(M3D_Context *, M3D_Sprite *, LONG, LONG);
+
+/**
+ * Perspective correction
+ */
+BOOL M3D_SetupPerspective(M3D_OrderedVertex *, M3D_OrderedVertex *, M3D_OrderedVertex *, M3D_DrawData *);
+VOID M3D_PerspectiveSpan(M3D_DrawData *, FLOAT, UWORD, ULONG, ULONG, LFIXED, LFIXED, UFIXED, SFIXED);
+
 /**
  * Drawing functions
  */
 
 // Flat shaded triangle
-VOID M3D_DrawFlatShadedTop(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawFlatShadedBottom(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawFlatShadedGeneric(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
+VOID M3D_DrawFlatShadedTop(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawFlatShadedBottom(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawFlatShadedGeneric(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
 
 // Flat shaded quad
-VOID M3D_DrawQuadFlatShadedTop(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadFlatShadedBottom(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadFlatShadedBoth(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadFlatShadedGeneric(M3D_Context *, M3D_Quad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatShadedTop(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatShadedBottom(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatShadedBoth(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatShadedGeneric(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
 
 // Gouraud shaded triangle
-VOID M3D_DrawGouraudShadedTop(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawGouraudShadedBottom(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawGouraudShadedGeneric(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
+VOID M3D_DrawGouraudShadedTop(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawGouraudShadedBottom(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawGouraudShadedGeneric(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
 
 // Gouraud shaded quad
-VOID M3D_DrawQuadGouraudShadedTop(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadGouraudShadedBottom(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadGouraudShadedBoth(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadGouraudShadedGeneric(M3D_Context *, M3D_Quad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudShadedTop(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudShadedBottom(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudShadedBoth(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudShadedGeneric(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
 
 // Flat textured triangle
-VOID M3D_DrawFlatTexturedTop(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawFlatTexturedBottom(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawFlatTexturedGeneric(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
+VOID M3D_DrawFlatTexturedTop(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawFlatTexturedBottom(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawFlatTexturedGeneric(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
 
 // Flat textured quad
-VOID M3D_DrawQuadFlatTexturedTop(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadFlatTexturedBottom(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadFlatTexturedBoth(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadFlatTexturedGeneric(M3D_Context *, M3D_Quad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatTexturedTop(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatTexturedBottom(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatTexturedBoth(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadFlatTexturedGeneric(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
 
 // Gouraud textured triangle
-VOID M3D_DrawGouraudTexturedTop(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawGouraudTexturedBottom(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
-VOID M3D_DrawGouraudTexturedGeneric(M3D_Context *, M3D_Triangle *, M3D_DrawData *);
+VOID M3D_DrawGouraudTexturedTop(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawGouraudTexturedBottom(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
+VOID M3D_DrawGouraudTexturedGeneric(M3D_Context *, M3D_OrderedTriangle *, M3D_DrawData *);
 
 // Gouraud textured quad
-VOID M3D_DrawQuadGouraudTexturedTop(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadGouraudTexturedBottom(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadGouraudTexturedBoth(M3D_Context *, M3D_Quad *, M3D_DrawData *);
-VOID M3D_DrawQuadGouraudTexturedGeneric(M3D_Context *, M3D_Quad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudTexturedTop(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudTexturedBottom(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudTexturedBoth(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
+VOID M3D_DrawQuadGouraudTexturedGeneric(M3D_Context *, M3D_OrderedQuad *, M3D_DrawData *);
 
 /** External function for rounding coordinates */
-extern VOID __asm M3D_FastRoundTriangle(
-  register __a0 M3D_Triangle *triangle
+extern VOID __asm M3D_FastRoundVertices(
+  register __a0 M3D_Vertex *vertices,
+  register __a1 M3D_OrderedVertex *ordered,
+  register __d0 ULONG count
 );
 
-/** External function for rounding coordinates */
-extern VOID __asm M3D_FastRoundQuad(
-  register __a0 M3D_Quad *quad
+/** External function feeding Maggie with the queued spans */
+extern VOID __asm M3D_FastFeedSpans(
+  register __a0 M3D_SpanCmd *spans,
+  register __d0 UWORD count,
+  register __a1 M3D_MaggieRegs *shadow,
+  register __a6 M3D_MaggieRegs *maggie
 );
 
 /** External function for draw region clear */
@@ -174,8 +483,8 @@ extern VOID __asm M3D_FastClearRegion32(
 );
 
 #if _ACTIVATE_DEBUG_ == 1
-VOID M3D_DumpTriangle(M3D_Triangle *);
-VOID M3D_DumpQuad(M3D_Quad *);
+VOID M3D_DumpTriangle(M3D_OrderedTriangle *);
+VOID M3D_DumpQuad(M3D_OrderedQuad *);
 VOID M3D_DumpSprite(M3D_Sprite *);
 VOID M3D_DumpDrawData(M3D_DrawData *);
 #endif
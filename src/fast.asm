@@ -87,6 +87,13 @@ VERTEX_V      = VERTEX_U+4
 VERTEX_LIGHT  = VERTEX_V+4
 VERTEX_SIZEOF = VERTEX_LIGHT+4
 
+; Ordered vertex structure
+ORDERED_X       = 0
+ORDERED_Y       = ORDERED_X+4
+ORDERED_Z       = ORDERED_Y+4
+ORDERED_VERTEX  = ORDERED_Z+4
+ORDERED_SIZEOF  = ORDERED_VERTEX+4
+
 ; Triangle structure
 TRIANGLE_V1           = 0
 TRIANGLE_V2           = TRIANGLE_V1+VERTEX_SIZEOF
@@ -104,70 +111,48 @@ QUAD_TEXTURE          = QUAD_V4+VERTEX_SIZEOF
 QUAD_COLOR            = QUAD_TEXTURE+4
 QUAD_SIZEOF           = QUAD_COLOR+4
 
-  SECTION fast,code
-
-;--------------------------------------
-; Fast round triangle vertex X & Y
-;
-; @in a0.l triangle address
-;--------------------------------------
-  xdef _M3D_FastRoundTriangle
+; Queued span structure
+SPAN_DEST             = 0
+SPAN_ZBUF             = SPAN_DEST+4
+SPAN_U                = SPAN_ZBUF+4
+SPAN_V                = SPAN_U+4
+SPAN_DU               = SPAN_V+4
+SPAN_DV               = SPAN_DU+4
+SPAN_LIGHT            = SPAN_DV+4
+SPAN_DLIGHT           = SPAN_LIGHT+2
+SPAN_Z                = SPAN_DLIGHT+2
+SPAN_DZ               = SPAN_Z+4
+SPAN_LENGTH           = SPAN_DZ+4
+SPAN_SIZEOF           = SPAN_LENGTH+4
 
-_M3D_FastRoundTriangle:
-  move.l  a0,-(sp)
-; Vertex v1
-  fint.s  VERTEX_X(a0),fp0
-  fint.s  VERTEX_Y(a0),fp1
-  fmove.s fp0,VERTEX_X(a0)
-  fmove.s fp1,VERTEX_Y(a0)
-; Vertex v2
-  lea     VERTEX_SIZEOF(a0),a0
-  fint.s  VERTEX_X(a0),fp0
-  fint.s  VERTEX_Y(a0),fp1
-  fmove.s fp0,VERTEX_X(a0)
-  fmove.s fp1,VERTEX_Y(a0)
-; Vertex v3
-  lea     VERTEX_SIZEOF(a0),a0
-  fint.s  VERTEX_X(a0),fp0
-  fint.s  VERTEX_Y(a0),fp1
-  fmove.s fp0,VERTEX_X(a0)
-  fmove.s fp1,VERTEX_Y(a0)
-  move.l  (sp)+,a0
-  rts
+  SECTION fast,code
 
 ;--------------------------------------
-; Fast round quad vertex X & Y
+; Fast round vertex X & Y in ordered vertices,
+; Z & the vertex address are only copied
 ;
-; @in a0.l quad address
+; @in a0.l vertices address
+; @in a1.l ordered vertices address
+; @in d0.l number of vertices
 ;--------------------------------------
-  xdef _M3D_FastRoundQuad
+  xdef _M3D_FastRoundVertices
 
-_M3D_FastRoundQuad:
-  move.l  a0,-(sp)
-; Vertex v1
-  fint.s  VERTEX_X(a0),fp0
-  fint.s  VERTEX_Y(a0),fp1
-  fmove.s fp0,VERTEX_X(a0)
-  fmove.s fp1,VERTEX_Y(a0)
-; Vertex v2
-  lea     VERTEX_SIZEOF(a0),a0
+_M3D_FastRoundVertices:
+  movem.l d0/a0/a1,-(sp)
+  bra.s   .NextVertex
+.RoundVertex:
   fint.s  VERTEX_X(a0),fp0
   fint.s  VERTEX_Y(a0),fp1
-  fmove.s fp0,VERTEX_X(a0)
-  fmove.s fp1,VERTEX_Y(a0)
-; Vertex v3
+  fmove.s fp0,ORDERED_X(a1)
+  fmove.s fp1,ORDERED_Y(a1)
+  move.l  VERTEX_Z(a0),ORDERED_Z(a1)
+  move.l  a0,ORDERED_VERTEX(a1)
   lea     VERTEX_SIZEOF(a0),a0
-  fint.s  VERTEX_X(a0),fp0
-  fint.s  VERTEX_Y(a0),fp1
-  fmove.s fp0,VERTEX_X(a0)
-  fmove.s fp1,VERTEX_Y(a0)
-; Vertex v4
-  lea     VERTEX_SIZEOF(a0),a0
-  fint.s  VERTEX_X(a0),fp0
-  fint.s  VERTEX_Y(a0),fp1
-  fmove.s fp0,VERTEX_X(a0)
-  fmove.s fp1,VERTEX_Y(a0)
-  move.l  (sp)+,a0
+  lea     ORDERED_SIZEOF(a1),a1
+.NextVertex:
+  subq.l  #1,d0
+  bpl.s   .RoundVertex
+  movem.l (sp)+,d0/a0/a1
   rts
 
 ;--------------------------------------
@@ -534,6 +519,66 @@ _M3D_FastFlatShading:
   movem.l (sp)+,d0-a6
   rts
 
+;--------------------------------------
+; Feed Maggie with queued spans
+; Deltas are only written when they change,
+; the shadow registers are updated on exit
+;
+; @in a0.l span queue
+; @in d0.w number of spans (> 0)
+; @in a1.l shadow registers
+; @in a6.l Maggie register
+;--------------------------------------
+  xdef _M3D_FastFeedSpans
+
+_M3D_FastFeedSpans:
+  movem.l d0-a6,-(sp)
+  move.l  TEXDUVAL(a1),d4
+  move.l  TEXDVVAL(a1),d5
+  move.w  TEXDLIGHT(a1),d6
+  move.l  TEXDZVAL(a1),d7
+  subq.w  #1,d0
+.NextSpan:
+  move.l  SPAN_DEST(a0),TEXDPT(a6)
+  move.l  SPAN_ZBUF(a0),TEXZPT(a6)
+  move.l  SPAN_U(a0),TEXUVAL(a6)
+  move.l  SPAN_V(a0),TEXVVAL(a6)
+  move.w  SPAN_LIGHT(a0),TEXLIGHT(a6)
+  move.l  SPAN_Z(a0),TEXZVAL(a6)
+  cmp.l   SPAN_DU(a0),d4
+  beq.s   .SameDU
+  move.l  SPAN_DU(a0),d4
+  move.l  d4,TEXDUVAL(a6)
+.SameDU:
+  cmp.l   SPAN_DV(a0),d5
+  beq.s   .SameDV
+  move.l  SPAN_DV(a0),d5
+  move.l  d5,TEXDVVAL(a6)
+.SameDV:
+  cmp.w   SPAN_DLIGHT(a0),d6
+  beq.s   .SameDLight
+  move.w  SPAN_DLIGHT(a0),d6
+  move.w  d6,TEXDLIGHT(a6)
+.SameDLight:
+  cmp.l   SPAN_DZ(a0),d7
+  beq.s   .SameDZ
+  move.l  SPAN_DZ(a0),d7
+  move.l  d7,TEXDZVAL(a6)
+.SameDZ:
+  move.w  SPAN_LENGTH(a0),d1
+.WaitBlitter:
+  btst    #14,CUSTOMBASE+$2
+  bne.s   .WaitBlitter
+  move.w  d1,TEXSTRT(a6)
+  lea     SPAN_SIZEOF(a0),a0
+  dbf     d0,.NextSpan
+  move.l  d4,TEXDUVAL(a1)
+  move.l  d5,TEXDVVAL(a1)
+  move.w  d6,TEXDLIGHT(a1)
+  move.l  d7,TEXDZVAL(a1)
+  movem.l (sp)+,d0-a6
+  rts
+
 ;--------------------------------------
 ;  MAGGIE EMULATION
 ;--------------------------------------
@@ -23,6 +23,7 @@
 #include "debug.h"
 #include "memory.h"
 #include "maggie.h"
+#include "draw.h"
 #include "Maggie3D.h"
 
 VOID __asm __saveds LIBM3D_FreeAllTextures(register __a0 M3D_Context *context);
@@ -145,6 +146,10 @@ M3D_Context __asm __saveds *LIBM3D_CreateContext(register __a0 LONG *error, regi
       context->flat_shading[1] = 0xaaaaaaaa;                // of 4x4 pixels used for flat shading
       context->maggie_available = LIBM3D_CheckMaggie();
       context->states = M3D_TEXMAPPING | M3D_GOURAUD | M3D_ZBUFFERUPDATE;
+      M3D_SelectKernels(context);
+      context->persp_span = M3D_PERSP16;
+      context->zbuffer_frames = 1;
+      context->z_scale = 1.0;
       if (context->drawregion.depth == 16) {
         context->mode = M3D_M_16BITS;
       } else if (context->drawregion.depth == 24) {
@@ -169,9 +174,27 @@ VOID __asm __saveds LIBM3D_DestroyContext(register __a0 M3D_Context *context)
     if (context->zbuffer.data != NULL) {
       M3D_FreeMem(context->zbuffer.data);
     }
+    if (context->hiz_data != NULL) {
+      M3D_FreeMem(context->hiz_data);
+    }
     if (context->flat_shading != NULL) {
       M3D_FreeMem(context->flat_shading);
     }
+    if (context->vertex_buffer != NULL) {
+      M3D_FreeMem(context->vertex_buffer);
+    }
+    if (context->prim_buffer != NULL) {
+      M3D_FreeMem(context->prim_buffer);
+    }
+    if (context->bin_buffer != NULL) {
+      M3D_FreeMem(context->bin_buffer);
+    }
+    if (context->dirty_data != NULL) {
+      M3D_FreeMem(context->dirty_data);
+    }
+    if (context->sort_buffer != NULL) {
+      M3D_FreeMem(context->sort_buffer);
+    }
     M3D_FreeMem(context);
   }
   // By security release all memory blocks
@@ -189,7 +212,10 @@ LONG __asm __saveds LIBM3D_SetDrawRegion(register __a0 M3D_Context *context , re
   }
   // Check for CGX bitmap
   if (GetCyberMapAttr(bitmap, CYBRMATTR_ISCYBERGFX)) {
+    // Binned figures are drawn in the previous region
+    M3D_FlushBins(context);
     context->drawregion.bitmap = bitmap;
+    M3D_SelectDirtyBuffer(context);
     if (scissor != NULL) {
       if (scissor->width < 8) {
         scissor->width = 8;
@@ -218,6 +244,8 @@ LONG __asm __saveds LIBM3D_SetScissor(register __a0 M3D_Context *context , regis
   if (scissor->width < 8) {
     scissor->width = 8;
   }
+  // Binned figures are clipped with the previous scissor
+  M3D_FlushBins(context);
   context->clipping.top = scissor->top;
   context->clipping.left = scissor->left;
   context->clipping.width = scissor->width;
@@ -250,6 +278,21 @@ LONG __asm __saveds LIBM3D_SetState(register __a0 M3D_Context *context, register
           context->mode &= ~M3D_M_ZBUFFER;
         }
         break;
+      case M3D_SPANQUEUE:
+        // Draw the pending spans before switching mode
+        M3D_FlushSpans();
+        break;
+      case M3D_BINNING:
+        // Draw the binned figures before switching mode
+        M3D_FlushBins(context);
+        break;
+      case M3D_DIRTYCLEAR:
+        if (!enable) {
+          M3D_FreeDirtyMap(context);
+        } else if (M3D_AllocDirtyMap(context) != M3D_SUCCESS) {
+          return M3D_NOMEMORY;
+        }
+        break;
       case M3D_ZBUFFERUPDATE:
         if (enable) {
           context->mode &= ~M3D_M_INHIBZBUF;
@@ -263,6 +306,7 @@ LONG __asm __saveds LIBM3D_SetState(register __a0 M3D_Context *context, register
     } else {
       context->states &= ~state;
     }
+    M3D_SelectKernels(context);
     //Dbug(kprintf("[MAGGIE3D] New state is 0x%lx \n", context->states);)
     return M3D_SUCCESS;
   }
@@ -277,3 +321,16 @@ BOOL __asm __saveds LIBM3D_GetState(register __a0 M3D_Context *context, register
   }
   return M3D_DISABLE;
 }
+
+/** Set the perspective correction span length */
+LONG __asm __saveds LIBM3D_SetPerspectiveSpan(register __a0 M3D_Context *context, register __d0 UWORD length)
+{
+  if (context == NULL) {
+    return M3D_NOCONTEXT;
+  }
+  if (length != M3D_PERSP8 && length != M3D_PERSP16 && length != M3D_PERSP32) {
+    return M3D_BADPARAM;
+  }
+  context->persp_span = length;
+  return M3D_SUCCESS;
+}
@@ -113,6 +113,80 @@ M3D_Quad Quad = {
   0xffffff
 };
 
+// Array of quads
+M3D_Quad QA_quads[] = {
+  {
+    440.0, 60.0, 30.0, 1.0, 0.0, 0.0, 1.0,
+    530.0, 60.0, 30.0, 1.0, 250.0, 0.0, 1.0,
+    530.0, 150.0, 30.0, 1.0, 250.0, 250.0, 0.6,
+    440.0, 150.0, 30.0, 1.0, 0.0, 250.0, 0.6,
+    NULL,
+    0xffffff
+  },
+  {
+    110.0, 330.0, 30.0, 1.0, 0.0, 0.0, 0.3,
+    230.0, 300.0, 30.0, 1.0, 250.0, 0.0, 0.6,
+    210.0, 420.0, 30.0, 1.0, 250.0, 250.0, 1.0,
+    120.0, 400.0, 30.0, 1.0, 0.0, 250.0, 0.6,
+    NULL,
+    0x80ff80
+  }
+};
+
+// List of quads
+M3D_Quad *LS_quads[] = {&QA_quads[0], &QA_quads[1]};
+
+// Mesh of 2x2 cells with shared vertices
+M3D_Vertex Mesh_vertices[] = {
+  120.0, 260.0, 20.0, 1.0, 0.0, 0.0, 1.0,
+  200.0, 260.0, 20.0, 1.0, 125.0, 0.0, 0.8,
+  280.0, 260.0, 20.0, 1.0, 250.0, 0.0, 0.6,
+  120.0, 340.0, 20.0, 1.0, 0.0, 125.0, 0.8,
+  200.0, 340.0, 20.0, 1.0, 125.0, 125.0, 0.6,
+  280.0, 340.0, 20.0, 1.0, 250.0, 125.0, 0.4,
+  120.0, 420.0, 20.0, 1.0, 0.0, 250.0, 0.6,
+  200.0, 420.0, 20.0, 1.0, 125.0, 250.0, 0.4,
+  280.0, 420.0, 20.0, 1.0, 250.0, 250.0, 0.2
+};
+
+// Clockwise triangles of the mesh
+UWORD Mesh_indices[] = {
+  0, 1, 3,  1, 4, 3,
+  1, 2, 4,  2, 5, 4,
+  3, 4, 6,  4, 7, 6,
+  4, 5, 7,  5, 8, 7
+};
+
+// Triangle strip, the vertices alternate between the bottom & the top
+M3D_Vertex Strip_vertices[] = {
+  300.0, 140.0, 20.0, 1.0, 0.0, 250.0, 1.0,
+  300.0, 60.0, 20.0, 1.0, 0.0, 0.0, 1.0,
+  380.0, 140.0, 20.0, 1.0, 125.0, 250.0, 0.7,
+  380.0, 60.0, 20.0, 1.0, 125.0, 0.0, 0.7,
+  460.0, 140.0, 20.0, 1.0, 250.0, 250.0, 0.4,
+  460.0, 60.0, 20.0, 1.0, 250.0, 0.0, 0.4
+};
+
+// Triangle fan, the center then the border in clockwise order
+M3D_Vertex Fan_vertices[] = {
+  440.0, 330.0, 20.0, 1.0, 125.0, 125.0, 1.0,
+  510.0, 330.0, 20.0, 1.0, 250.0, 125.0, 0.2,
+  461.6, 396.6, 20.0, 1.0, 164.0, 250.0, 0.2,
+  383.4, 371.1, 20.0, 1.0, 24.0, 200.0, 0.2,
+  383.4, 288.9, 20.0, 1.0, 24.0, 50.0, 0.2,
+  461.6, 263.4, 20.0, 1.0, 164.0, 0.0, 0.2,
+  510.0, 330.0, 20.0, 1.0, 250.0, 125.0, 0.2
+};
+
+// Triangle in homogeneous clip space, partly outside of the frustum
+M3D_Triangle Clip_triangle = {
+  -1.2, -0.8, 0.5, 1.0, 0.0, 250.0, 1.0,
+  0.0, 1.3, 0.5, 1.0, 125.0, 0.0, 0.6,
+  0.6, -0.6, 0.5, 1.0, 250.0, 250.0, 0.2,
+  NULL,
+  0xffffff
+};
+
 // Sprite
 M3D_Sprite Sprite = {
   0, 0, 176, 254,           // Left, top, width, height
@@ -123,6 +197,16 @@ M3D_Sprite Sprite = {
   0xffffff                  // Color
 };
 
+// Array of sprites & their positions
+M3D_Sprite SA_sprites[] = {
+  { 0, 0, 176, 254, 0.5, 0.5, 0.0, TRUE, FALSE, NULL, 1.0, 0xffffff },
+  { 0, 0, 176, 254, 0.4, 0.4, 20.0, FALSE, FALSE, NULL, 0.7, 0xffc0c0 }
+};
+M3D_Position SA_positions[] = {
+  { 110, 60 },
+  { 420, 200 }
+};
+
 struct TagItem TexTags[] = {
   M3D_TT_FILENAME, (ULONG) "warrior.bmp",
   M3D_TT_AUTORESIZE, TRUE,
@@ -259,6 +343,11 @@ int main(int argc, char **argv)
               G1_triangle.texture = mytexture_dds;
               G2_triangle.texture = mytexture_bmp;
               Sprite.texture = mytexture_spr;
+              QA_quads[0].texture = mytexture_dds;
+              QA_quads[1].texture = mytexture_bmp;
+              Clip_triangle.texture = mytexture_dds;
+              SA_sprites[0].texture = mytexture_spr;
+              SA_sprites[1].texture = mytexture_spr;
               M3D_SetDrawRegion(mycontext, CyberScreen->RastPort.BitMap, &myscissor);
               if (M3D_LockHardware(mycontext) == M3D_SUCCESS) {
                 M3D_ClearZBuffer(mycontext);
@@ -275,6 +364,46 @@ int main(int argc, char **argv)
                 M3D_DrawQuad(mycontext, &Quad);
                 printf("- Draw a sprite\n");
                 M3D_DrawSprite(mycontext, &Sprite, 180, 80);
+                printf("- Draw a quad array\n");
+                M3D_DrawQuadArray(mycontext, QA_quads, 2);
+                printf("- Draw a sprite array\n");
+                M3D_DrawSpriteArray(mycontext, SA_sprites, SA_positions, 2);
+                M3D_UnlockHardware(mycontext);
+              }
+              printf("- Use 2 Z buffer frames, bin the figures, queue the spans & cull the back faces\n");
+              M3D_SetZBufferFrames(mycontext, 2);
+              M3D_SetState(mycontext, M3D_DIRTYCLEAR, M3D_ENABLE);
+              M3D_SetState(mycontext, M3D_BINNING, M3D_ENABLE);
+              M3D_SetState(mycontext, M3D_SPANQUEUE, M3D_ENABLE);
+              M3D_SetState(mycontext, M3D_CULLBACK, M3D_ENABLE);
+              if (M3D_LockHardware(mycontext) == M3D_SUCCESS) {
+                // The figures of this frame are in front of the previous ones
+                M3D_ClearZBuffer(mycontext);
+                printf("- Draw indexed triangles\n");
+                M3D_DrawIndexedTriangles(mycontext, Mesh_vertices, Mesh_indices, 8, mytexture_dds, M3D_INDEX16, 0xffffff);
+                printf("- Draw a triangle strip\n");
+                M3D_DrawTriangleStrip(mycontext, Strip_vertices, 6, mytexture_bmp, 0xffffff);
+                printf("- Draw a triangle fan\n");
+                M3D_DrawTriangleFan(mycontext, Fan_vertices, 7, mytexture_dds, 0xffc080);
+                // The binned figures are drawn tile by tile when the hardware is unlocked
+                M3D_UnlockHardware(mycontext);
+              }
+              M3D_SetState(mycontext, M3D_BINNING, M3D_DISABLE);
+              M3D_SetState(mycontext, M3D_CULLBACK, M3D_DISABLE);
+              printf("- Sort a scene by states with perspective correction\n");
+              M3D_SetState(mycontext, M3D_STATESORT, M3D_ENABLE);
+              M3D_SetState(mycontext, M3D_PERSPECTIVE, M3D_ENABLE);
+              M3D_SetPerspectiveSpan(mycontext, 16);
+              if (M3D_LockHardware(mycontext) == M3D_SUCCESS) {
+                M3D_ClearZBuffer(mycontext);
+                M3D_BeginScene(mycontext);
+                printf("- Draw a quad list\n");
+                M3D_DrawQuadList(mycontext, LS_quads, 2);
+                M3D_EndScene(mycontext);
+                printf("- Clip a triangle against the frustum\n");
+                M3D_SetState(mycontext, M3D_FRUSTUMCLIP, M3D_ENABLE);
+                M3D_DrawTriangle(mycontext, &Clip_triangle);
+                M3D_SetState(mycontext, M3D_FRUSTUMCLIP, M3D_DISABLE);
                 M3D_UnlockHardware(mycontext);
               }
               M3D_FreeTexture(mycontext, mytexture_spr);
@@ -0,0 +1,547 @@
+/**
+ * scene.c
+ *
+ * Maggie3D shared library
+ * Deferred rendering functions (tile binning & depth sorted scene)
+ *
+ * @author Fabrice Labrador <fabrice.labrador@gmail.com>
+ * @version 1.7 (updated: 17/10/2026)
+ */
+
+#include <stdio.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "debug.h"
+#include "memory.h"
+#include "draw.h"
+
+/** Maggie registers */
+extern M3D_MaggieRegs *maggie;
+extern M3D_MaggieRegs maggie_shadow;
+extern UWORD span_count;
+
+#if _ACTIVATE_DEBUG_ == 1
+extern BOOL draw_debug;
+#endif
+
+/*****************************************************************************/
+/**                     PRIMITIVE BUFFER                                     */
+/*****************************************************************************/
+
+/** Get a free primitive in the context buffer, NULL if no more memory */
+M3D_Primitive *M3D_NewPrimitive(M3D_Context *context)
+{
+  M3D_Primitive *buffer;
+  M3D_SortKey *keys;
+  ULONG size;
+
+  // Grow the primitive buffer of the context if needed
+  if (context->prim_count == context->prim_buffer_size) {
+    size = (context->prim_buffer_size == 0) ? M3D_PRIM_BLOCK : context->prim_buffer_size * 2;
+    buffer = M3D_AllocMem(size * sizeof(M3D_Primitive));
+    if (buffer == NULL) {
+      return NULL;
+    }
+    if (context->prim_buffer != NULL) {
+      CopyMem(context->prim_buffer, buffer, context->prim_count * sizeof(M3D_Primitive));
+      M3D_FreeMem(context->prim_buffer);
+    }
+    context->prim_buffer = buffer;
+    context->prim_buffer_size = size;
+    DDbug(kprintf("[MAGGIE3D] Primitive buffer grown to %ld primitives\n", size);)
+  }
+  // A scene is sorted without allocation, the sort buffer holds two keys per primitive
+  if (context->scene && context->sort_buffer_size < context->prim_buffer_size) {
+    keys = M3D_AllocMem(context->prim_buffer_size * 2 * sizeof(M3D_SortKey));
+    if (keys == NULL) {
+      return NULL;
+    }
+    if (context->sort_buffer != NULL) {
+      M3D_FreeMem(context->sort_buffer);
+    }
+    context->sort_buffer = keys;
+    context->sort_buffer_size = context->prim_buffer_size;
+  }
+  return &((M3D_Primitive *) context->prim_buffer)[context->prim_count++];
+}
+
+/** Store a figure with the current states, return FALSE if it is outside of the clipping region */
+BOOL M3D_StorePrimitive(M3D_Context *context, UWORD type, APTR figure, M3D_Vertex *vertices, ULONG count)
+{
+  M3D_Primitive *primitive;
+  FLOAT min_x, min_y, max_x, max_y, depth;
+  ULONG index;
+
+  // Bounding box & average Z of the figure
+  min_x = max_x = vertices[0].x;
+  min_y = max_y = vertices[0].y;
+  depth = vertices[0].z;
+  for (index = 1;index < count;index++) {
+    depth += vertices[index].z;
+    if (vertices[index].x < min_x) {
+      min_x = vertices[index].x;
+    } else if (vertices[index].x > max_x) {
+      max_x = vertices[index].x;
+    }
+    if (vertices[index].y < min_y) {
+      min_y = vertices[index].y;
+    } else if (vertices[index].y > max_y) {
+      max_y = vertices[index].y;
+    }
+  }
+  // Reject the bounding box, the figure is rounded later so it can reach the next pixel
+  if (max_x < (FLOAT) context->clipping.left || min_x > (FLOAT) (context->clipping.left + context->clipping.width - 1) ||
+      max_y < (FLOAT) context->clipping.top || min_y > (FLOAT) (context->clipping.top + context->clipping.height - 1)) {
+    DDbug(kprintf("[MAGGIE3D] Figure out of clipping region, not stored\n");)
+    return FALSE;
+  }
+  primitive = M3D_NewPrimitive(context);
+  if (primitive == NULL) {
+    // No more memory, draw the pending figures to get a free primitive
+    M3D_FlushBins(context);
+    primitive = M3D_NewPrimitive(context);
+    if (primitive == NULL) {
+      return FALSE;
+    }
+  }
+  primitive->type = type;
+  primitive->states = context->states & ~M3D_BINNING;
+  primitive->mode = context->mode;
+  primitive->depth = M3D_DepthKey(depth / count);
+  if (type == PRIM_TRIANGLE) {
+    CopyMem(figure, &(primitive->figure.triangle), sizeof(M3D_Triangle));
+  } else {
+    CopyMem(figure, &(primitive->figure.quad), sizeof(M3D_Quad));
+  }
+  return TRUE;
+}
+
+/*****************************************************************************/
+/**                       TILE BINNING                                       */
+/*****************************************************************************/
+
+/** Get a free span in the tile bins with the current registers, the span is queued for Maggie if no more memory */
+M3D_SpanCmd *M3D_NextBinSpan(M3D_Context *context)
+{
+  M3D_BinSpan *buffer, *span;
+  APTR texture;
+  ULONG size, color;
+  UWORD tex_size, mode, modulo;
+
+  // Grow the span buffer of the context if needed
+  if (context->bin_count == context->bin_buffer_size) {
+    size = (context->bin_buffer_size == 0) ? M3D_BIN_BLOCK : context->bin_buffer_size * 2;
+    buffer = M3D_AllocMem(size * sizeof(M3D_BinSpan));
+    if (buffer == NULL) {
+      // No more memory, draw the binned spans & restore the registers of the figure
+      texture = maggie_shadow.texture;
+      color = maggie_shadow.color;
+      tex_size = maggie_shadow.tex_size;
+      mode = maggie_shadow.mode;
+      modulo = maggie_shadow.modulo;
+      M3D_FlushBins(context);
+      M3D_SetReg(texture, texture);
+      M3D_SetReg(color, color);
+      M3D_SetReg(tex_size, tex_size);
+      M3D_SetReg(mode, mode);
+      M3D_SetReg(modulo, modulo);
+      if (context->bin_buffer_size == 0) {
+        return M3D_NextSpan();
+      }
+    } else {
+      if (context->bin_buffer != NULL) {
+        CopyMem(context->bin_buffer, buffer, context->bin_count * sizeof(M3D_BinSpan));
+        M3D_FreeMem(context->bin_buffer);
+      }
+      context->bin_buffer = buffer;
+      context->bin_buffer_size = size;
+      DDbug(kprintf("[MAGGIE3D] Bin buffer grown to %ld spans\n", size);)
+    }
+  }
+  span = &((M3D_BinSpan *) context->bin_buffer)[context->bin_count++];
+  span->texture = maggie_shadow.texture;
+  span->color = maggie_shadow.color;
+  span->tex_size = maggie_shadow.tex_size;
+  span->mode = maggie_shadow.mode;
+  span->modulo = maggie_shadow.modulo;
+  return &(span->cmd);
+}
+
+/** Draw the part of a binned span between two X coordinates, the start values move with the skipped pixels */
+VOID M3D_DrawBinSpan(M3D_Context *context, M3D_BinSpan *bin, ULONG left, ULONG right)
+{
+  M3D_SpanCmd *span;
+  ULONG skip, length;
+
+  if (bin->x >= right || bin->x + bin->cmd.length <= left) {
+    return;
+  }
+  skip = (left > bin->x) ? left - bin->x : 0;
+  length = ((bin->x + bin->cmd.length > right) ? right - bin->x : bin->cmd.length) - skip;
+  M3D_SetReg(mode, bin->mode);
+  M3D_SetReg(modulo, bin->modulo);
+  M3D_SetReg(texture, bin->texture);
+  M3D_SetReg(tex_size, bin->tex_size);
+  M3D_SetReg(color, bin->color);
+  if (context->states & M3D_SPANQUEUE) {
+    span = M3D_NextSpan();
+    span->destination = (APTR) ((ULONG) bin->cmd.destination + (skip * context->drawregion.bpp));
+    span->zbuffer = (APTR) ((ULONG) bin->cmd.zbuffer + (skip * context->zbuffer.bpp));
+    span->u_start = bin->cmd.u_start + (bin->cmd.u_delta * skip);
+    span->v_start = bin->cmd.v_start + (bin->cmd.v_delta * skip);
+    span->u_delta = bin->cmd.u_delta;
+    span->v_delta = bin->cmd.v_delta;
+    span->light_start = (UFIXED) (bin->cmd.light_start + (bin->cmd.light_delta * skip));
+    span->light_delta = bin->cmd.light_delta;
+    span->z_start = bin->cmd.z_start + (bin->cmd.z_delta * skip);
+    span->z_delta = bin->cmd.z_delta;
+    span->length = (UWORD) length;
+  } else {
+    maggie->destination = (APTR) ((ULONG) bin->cmd.destination + (skip * context->drawregion.bpp));
+    maggie->zbuffer = (APTR) ((ULONG) bin->cmd.zbuffer + (skip * context->zbuffer.bpp));
+    maggie->u_start = bin->cmd.u_start + (bin->cmd.u_delta * skip);
+    maggie->v_start = bin->cmd.v_start + (bin->cmd.v_delta * skip);
+    M3D_SetReg(u_delta, bin->cmd.u_delta);
+    M3D_SetReg(v_delta, bin->cmd.v_delta);
+    maggie->light_start = (UFIXED) (bin->cmd.light_start + (bin->cmd.light_delta * skip));
+    M3D_SetReg(light_delta, bin->cmd.light_delta);
+    maggie->z_start = bin->cmd.z_start + (bin->cmd.z_delta * skip);
+    M3D_SetReg(z_delta, bin->cmd.z_delta);
+    WaitBlit();
+    maggie->start_length = (UWORD) length;
+    M3D_EmulateSpan(bin->texture != (APTR) context->flat_shading);
+  }
+}
+
+/** Draw the binned spans tile by tile, or the scene figures sorted by depth */
+VOID M3D_FlushBins(M3D_Context *context)
+{
+  M3D_BinSpan *buffer, *span;
+  ULONG *first, *last, count, index, offset, rows, columns, tile_x, tile_y;
+
+  if (context->scene) {
+    if (context->prim_count != 0) {
+      M3D_FlushScene(context);
+    }
+    return;
+  }
+  if (context->bin_count == 0) {
+    return;
+  }
+  DDbug(kprintf("[MAGGIE3D] Flushing %ld binned spans\n", context->bin_count);)
+  // Empty the bins first, spans queued before the binned ones are drawn first
+  buffer = (M3D_BinSpan *) context->bin_buffer;
+  count = context->bin_count;
+  context->bin_count = 0;
+  M3D_FlushSpans();
+  rows = (context->drawregion.height + M3D_TILE_HEIGHT - 1) / M3D_TILE_HEIGHT;
+  columns = (context->drawregion.width + M3D_TILE_WIDTH - 1) / M3D_TILE_WIDTH;
+  first = M3D_AllocMem(rows * 2 * sizeof(ULONG));
+  if (first == NULL) {
+    // No more memory, draw the spans in the submission order
+    for (index = 0;index < count;index++) {
+      M3D_DrawBinSpan(context, &buffer[index], 0, context->drawregion.width);
+    }
+    return;
+  }
+  last = first + rows;
+  for (tile_y = 0;tile_y < rows;tile_y++) {
+    first[tile_y] = M3D_BIN_END;
+  }
+  // Chain the spans of each tile row in the submission order
+  for (index = 0;index < count;index++) {
+    span = &buffer[index];
+    offset = (ULONG) span->cmd.destination - (ULONG) context->drawregion.data;
+    span->y = (UWORD) (offset / context->drawregion.bpr);
+    span->x = (UWORD) ((offset % context->drawregion.bpr) / context->drawregion.bpp);
+    span->next = M3D_BIN_END;
+    tile_y = span->y / M3D_TILE_HEIGHT;
+    if (first[tile_y] == M3D_BIN_END) {
+      first[tile_y] = index;
+    } else {
+      buffer[last[tile_y]].next = index;
+    }
+    last[tile_y] = index;
+  }
+  // The figures were set up once, their spans are only cut at the tile edges
+  for (tile_y = 0;tile_y < rows;tile_y++) {
+    for (tile_x = 0;tile_x < columns;tile_x++) {
+      for (index = first[tile_y];index != M3D_BIN_END;index = buffer[index].next) {
+        M3D_DrawBinSpan(context, &buffer[index], tile_x * M3D_TILE_WIDTH, (tile_x + 1) * M3D_TILE_WIDTH);
+      }
+    }
+  }
+  M3D_FreeMem(first);
+}
+
+/*****************************************************************************/
+/**                     DEPTH SORTED SCENE                                   */
+/*****************************************************************************/
+
+/** Store a triangle in the scene */
+ULONG M3D_SceneTriangle(M3D_Context *context, M3D_Triangle *triangle)
+{
+  if (M3D_StorePrimitive(context, PRIM_TRIANGLE, triangle, &(triangle->v1), 3)) {
+    return TRI_GENERIC;
+  }
+  return TRI_REJECTED;
+}
+
+/** Store a quad in the scene */
+ULONG M3D_SceneQuad(M3D_Context *context, M3D_Quad *quad)
+{
+  if (M3D_StorePrimitive(context, PRIM_QUAD, quad, &(quad->v1), 4)) {
+    return QUAD_GENERIC;
+  }
+  return QUAD_REJECTED;
+}
+
+/** Draw a stored figure with its drawing states */
+VOID M3D_DrawPrimitive(M3D_Context *context, M3D_Primitive *primitive)
+{
+  M3D_DrawData draw_data;
+
+  context->states = primitive->states;
+  context->mode = primitive->mode;
+  M3D_SelectKernels(context);
+  if (primitive->type == PRIM_SPRITE) {
+    if (primitive->figure.sprite.sprite.angle == 0.0) {
+      M3D_DrawNormalSprite(context, &(primitive->figure.sprite.sprite), primitive->figure.sprite.position.x, primitive->figure.sprite.position.y);
+    } else {
+      M3D_DrawRotatedSprite(context, &(primitive->figure.sprite.sprite), primitive->figure.sprite.position.x, primitive->figure.sprite.position.y);
+    }
+    return;
+  }
+  M3D_SetupDrawData(context, &draw_data);
+  if (primitive->type == PRIM_TRIANGLE) {
+    M3D_RenderTriangle(context, &(primitive->figure.triangle), &draw_data);
+  } else {
+    M3D_RenderQuad(context, &(primitive->figure.quad), &draw_data);
+  }
+}
+
+/** Convert a depth to a sort key, the keys of the IEEE floats have the same order as the floats */
+ULONG M3D_DepthKey(FLOAT depth)
+{
+  union {
+    FLOAT value;
+    ULONG bits;
+  } key;
+
+  key.value = depth;
+  if (key.bits & 0x80000000) {
+    return ~key.bits;
+  }
+  return key.bits | 0x80000000;
+}
+
+/** Store a sprite in the scene, it is drawn over the scene figures */
+LONG M3D_SceneSprite(M3D_Context *context, M3D_Sprite *sprite, LONG xpos, LONG ypos)
+{
+  M3D_Primitive *primitive;
+
+  primitive = M3D_NewPrimitive(context);
+  if (primitive == NULL) {
+    // No more memory, draw the pending figures to get a free primitive
+    M3D_FlushBins(context);
+    primitive = M3D_NewPrimitive(context);
+    if (primitive == NULL) {
+      return M3D_NOMEMORY;
+    }
+  }
+  primitive->type = PRIM_SPRITE;
+  primitive->states = context->states & ~M3D_BINNING;
+  primitive->mode = context->mode;
+  primitive->depth = 0;
+  CopyMem(sprite, &(primitive->figure.sprite.sprite), sizeof(M3D_Sprite));
+  primitive->figure.sprite.position.x = xpos;
+  primitive->figure.sprite.position.y = ypos;
+  return M3D_SUCCESS;
+}
+
+/** Sort the keys by increasing depth with a radix sort of 8 bits per pass, return the buffer holding the sorted keys */
+M3D_SortKey *M3D_RadixSort(M3D_SortKey *keys, M3D_SortKey *temp, ULONG count)
+{
+  M3D_SortKey *swap;
+  ULONG histogram[256], offset, total, index, shift;
+
+  if (count < 2) {
+    return keys;
+  }
+  for (shift = 0;shift < 32;shift += 8) {
+    for (index = 0;index < 256;index++) {
+      histogram[index] = 0;
+    }
+    for (index = 0;index < count;index++) {
+      histogram[(keys[index].key >> shift) & 0xff]++;
+    }
+    // All the keys share this digit, the order does not change
+    if (histogram[(keys[0].key >> shift) & 0xff] == count) {
+      continue;
+    }
+    offset = 0;
+    for (index = 0;index < 256;index++) {
+      total = histogram[index];
+      histogram[index] = offset;
+      offset += total;
+    }
+    // Stable move of the keys in their bucket
+    for (index = 0;index < count;index++) {
+      temp[histogram[(keys[index].key >> shift) & 0xff]++] = keys[index];
+    }
+    swap = keys;
+    keys = temp;
+    temp = swap;
+  }
+  return keys;
+}
+
+/** Texture drawn on a figure, NULL for a shaded figure */
+M3D_Texture *M3D_PrimitiveTexture(M3D_Primitive *primitive)
+{
+  if (!(primitive->states & M3D_TEXMAPPING)) {
+    return NULL;
+  }
+  if (primitive->type == PRIM_TRIANGLE) {
+    return primitive->figure.triangle.texture;
+  }
+  return primitive->figure.quad.texture;
+}
+
+/** Check if a figure is drawn front to back, only the opaque figures tested against the Z buffer are */
+BOOL M3D_FrontToBack(M3D_Primitive *primitive)
+{
+  M3D_Texture *texture;
+
+  if (!(primitive->mode & M3D_M_ZBUFFER)) {
+    return FALSE;
+  }
+  // Transparent texels do not write the Z buffer, the figures behind must be drawn first
+  texture = M3D_PrimitiveTexture(primitive);
+  if (texture != NULL && texture->transparency) {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/** Group the figures by states, then texture, then color, the figures keep their order inside a group */
+M3D_SortKey *M3D_SortStates(M3D_Primitive *buffer, M3D_SortKey *keys, M3D_SortKey *temp, ULONG count)
+{
+  M3D_Primitive *primitive;
+  M3D_SortKey *sorted;
+  ULONG pass, index;
+
+  // The least significant key is sorted first
+  for (pass = 0;pass < 3;pass++) {
+    for (index = 0;index < count;index++) {
+      primitive = &buffer[keys[index].index];
+      if (pass == 0) {
+        keys[index].key = (primitive->type == PRIM_TRIANGLE) ? primitive->figure.triangle.color : primitive->figure.quad.color;
+      } else if (pass == 1) {
+        keys[index].key = (ULONG) M3D_PrimitiveTexture(primitive);
+      } else {
+        keys[index].key = ((ULONG) primitive->states << 16) | primitive->mode;
+      }
+    }
+    sorted = M3D_RadixSort(keys, temp, count);
+    if (sorted != keys) {
+      temp = keys;
+      keys = sorted;
+    }
+  }
+  return keys;
+}
+
+/** Draw the scene figures, opaque ones front to back, then the other ones back to front and the sprites */
+VOID M3D_FlushScene(M3D_Context *context)
+{
+  M3D_Primitive *primitive, *buffer;
+  M3D_SortKey *keys, *sorted, *opaque;
+  WORDBITS states, mode;
+  ULONG count, index, total, others;
+
+  DDbug(kprintf("[MAGGIE3D] Flushing %ld scene figures\n", context->prim_count);)
+  // Empty the scene first, figures are drawn and not stored again
+  buffer = (M3D_Primitive *) context->prim_buffer;
+  count = context->prim_count;
+  context->prim_count = 0;
+  context->scene = FALSE;
+  states = context->states;
+  mode = context->mode;
+  // One sort gives both orders
+  keys = (M3D_SortKey *) context->sort_buffer;
+  for (index = 0;index < count;index++) {
+    keys[index].key = buffer[index].depth;
+    keys[index].index = index;
+  }
+  sorted = M3D_RadixSort(keys, keys + context->sort_buffer_size, count);
+  if (states & M3D_STATESORT) {
+    // Move the opaque keys in the free half, the other keys stay sorted at the start of their half
+    opaque = (sorted == keys) ? keys + context->sort_buffer_size : keys;
+    total = 0;
+    others = 0;
+    for (index = 0;index < count;index++) {
+      primitive = &buffer[sorted[index].index];
+      if (primitive->type != PRIM_SPRITE && M3D_FrontToBack(primitive)) {
+        opaque[total++] = sorted[index];
+      } else {
+        sorted[others++] = sorted[index];
+      }
+    }
+    // The end of the sorted keys is free for the state sort
+    opaque = M3D_SortStates(buffer, opaque, sorted + others, total);
+    for (index = 0;index < total;index++) {
+      M3D_DrawPrimitive(context, &buffer[opaque[index].index]);
+    }
+    count = others;
+  } else {
+    for (index = 0;index < count;index++) {
+      primitive = &buffer[sorted[index].index];
+      if (primitive->type != PRIM_SPRITE && M3D_FrontToBack(primitive)) {
+        M3D_DrawPrimitive(context, primitive);
+      }
+    }
+  }
+  for (index = count;index-- > 0;) {
+    primitive = &buffer[sorted[index].index];
+    if (primitive->type != PRIM_SPRITE && !M3D_FrontToBack(primitive)) {
+      M3D_DrawPrimitive(context, primitive);
+    }
+  }
+  // The sprites keep the submission order, they share the same key
+  for (index = 0;index < count;index++) {
+    primitive = &buffer[sorted[index].index];
+    if (primitive->type == PRIM_SPRITE) {
+      M3D_DrawPrimitive(context, primitive);
+    }
+  }
+  context->states = states;
+  context->mode = mode;
+  M3D_SelectKernels(context);
+  context->scene = TRUE;
+}
+
+/** Start a scene, the figures & sprites are stored until the end of the scene */
+LONG __asm __saveds LIBM3D_BeginScene(register __a0 M3D_Context *context)
+{
+  if (context == NULL) {
+    return M3D_NOCONTEXT;
+  }
+  // Binned figures are drawn before the scene
+  M3D_FlushBins(context);
+  context->scene = TRUE;
+  return M3D_SUCCESS;
+}
+
+/** End a scene and draw its figures sorted by depth */
+LONG __asm __saveds LIBM3D_EndScene(register __a0 M3D_Context *context)
+{
+  if (context == NULL) {
+    return M3D_NOCONTEXT;
+  }
+  M3D_FlushBins(context);
+  context->scene = FALSE;
+  return M3D_SUCCESS;
+}
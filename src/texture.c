@@ -20,6 +20,7 @@
 #include "debug.h"
 #include "memory.h"
 #include "texture.h"
+#include "draw.h"
 #include "Maggie3D.h"
 
 /** Check if texture size is valid */
@@ -254,6 +255,7 @@ APTR M3D_ResizeTexture(M3D_Texture *texture, APTR data)
   texture->width = width;
   texture->height = height;
   texture->mipsize = M3D_GetTextureMipmapSize(width);
+  texture->scale = 65536.0 * 256.0 / width;
   Dbug(kprintf("[MAGGIE3D] Texture resized to %ld x %ld\n", width, height);)
   return new_data;
 }
@@ -340,13 +342,14 @@ M3D_Texture __asm __saveds *LIBM3D_AllocTextureTagList(
       texture->width = width;
       texture->height = height;
       texture->mipsize = M3D_GetTextureMipmapSize(width);
+      // Texture coordinates scale, computed once for all the figures
+      texture->scale = 65536.0 * 256.0 / width;
       texture->filtering = M3D_NEAREST;
       Dbug(kprintf(
           "[MAGGIE3D] Allocate texture => width=%ld, height=%ld, mipsize=%ld,  filtering=%ld\n",
           texture->width, texture->height, texture->mipsize, texture->filtering
       );)
       if (pixformat == M3D_PIXFMT_DXT1) {
-#if _USE_MAGGIE_ == 1
         Dbug(kprintf("[MAGGIE3D] Native DXT1 texture, no conversion needed\n");)
         if ((texture->data = M3D_AllocAlignMem(M3D_GetTextureDataSize(texture->mipsize), TEX_DATAALIGN)) == NULL) {
           M3D_FreeMem(texture);
@@ -354,16 +357,8 @@ M3D_Texture __asm __saveds *LIBM3D_AllocTextureTagList(
           return NULL;
         }
         CopyMem(data, texture->data, M3D_GetTextureDataSize(texture->mipsize));
+        texture->transparency = M3D_CheckDXT1Transparency((UBYTE *) data, M3D_GetTextureDataSize(texture->mipsize) / 8);
         *error = M3D_SUCCESS;
-#else
-        Dbug(kprintf("[MAGGIE3D] DXT1 texture, decompression to RGBA needed\n");)
-        if ((texture->data = M3D_AllocMem(texture->width * texture->height * 4)) == NULL) {
-          M3D_FreeMem(texture);
-          *error = M3D_NOMEMORY;
-          return NULL;
-        }
-        *error = M3D_ConvertFromDXT1(texture, data);
-#endif
         if (!M3D_AddTexture(context, texture)) {
           M3D_FreeMem(texture);
           *error = M3D_TEXLIMIT;
@@ -399,6 +394,7 @@ M3D_Texture __asm __saveds *LIBM3D_AllocTextureTagList(
         } else if (pixformat == M3D_PIXFMT_ARGB32) {
           M3D_ConvertARBG32ToRGBA32((ULONG *)data, (UBYTE *)tmp_data, texture->width, texture->height, transparency, color);
         }
+        texture->transparency = M3D_CheckRGBATransparency((UBYTE *) tmp_data, texture->width * texture->height);
         // Resize if requested
         if (autoresize) {
           data = M3D_ResizeTexture(texture, tmp_data);
@@ -410,7 +406,7 @@ M3D_Texture __asm __saveds *LIBM3D_AllocTextureTagList(
           }
           tmp_data = data;
         }
-#if _USE_MAGGIE_ == 1
+        // Compress to DXT1, the format sampled by Maggie & by the emulator
         if ((texture->data = M3D_AllocAlignMem(M3D_GetTextureDataSize(texture->mipsize), TEX_DATAALIGN)) == NULL) {
           M3D_FreeMem(tmp_data);
           M3D_FreeMem(texture);
@@ -424,10 +420,6 @@ M3D_Texture __asm __saveds *LIBM3D_AllocTextureTagList(
           M3D_FreeMem(texture);
           return NULL;
         }
-#else
-        Dbug(kprintf("[MAGGIE3D] No conversion to DXT1 (Maggie not used)\n");)
-        texture->data = tmp_data;
-#endif
         if (!M3D_AddTexture(context, texture)) {
           M3D_FreeMem(texture);
           *error = M3D_TEXLIMIT;
@@ -506,6 +498,10 @@ VOID __asm __saveds LIBM3D_FreeTexture(register __a0 M3D_Context *context, regis
   if (texture != NULL) {
     Dbug(kprintf("[MAGGIE3D] Free texture\n");)
     M3D_RemoveTexture(context, texture);
+#if _USE_MAGGIE_ == 0
+    // The emulator may keep decoded blocks of this texture
+    M3D_FlushBlockCache();
+#endif
     M3D_FreeMem(texture->data);
     M3D_FreeMem(texture);
   }
@@ -59,6 +59,9 @@ BOOL M3D_CheckDDSFile(STRPTR);
 M3D_TextureFile *M3D_LoadDDSTexture(LONG *, STRPTR);
 M3D_TextureFile *M3D_LoadBMPTexture(LONG *, STRPTR);
 LONG M3D_ConvertToDXT1(M3D_Texture *, APTR, ULONG);
-LONG M3D_ConvertFromDXT1(M3D_Texture *, APTR);
+VOID FLR_DecodeColors(ULONG *, UWORD, UWORD);
+VOID FLR_DecodePixels(ULONG, ULONG *, ULONG *, ULONG);
+BOOL M3D_CheckRGBATransparency(UBYTE *, ULONG);
+BOOL M3D_CheckDXT1Transparency(UBYTE *, ULONG);
 
 #endif
@@ -13,8 +13,13 @@
 #include "debug.h"
 #include "memory.h"
 #include "zbuffer.h"
+#include "draw.h"
 #include "Maggie3D.h"
 
+#if _ACTIVATE_DEBUG_ == 1
+extern BOOL draw_debug;
+#endif
+
 /** Allocate the Z buffer */
 LONG __asm __saveds LIBM3D_AllocZBuffer(register __a0 M3D_Context *context)
 {
@@ -27,6 +32,18 @@ LONG __asm __saveds LIBM3D_AllocZBuffer(register __a0 M3D_Context *context)
     if (context->zbuffer.data == NULL) {
       return M3D_NOMEMORY;
     }
+    // Hierarchical Z buffer, the Z buffer still works without it
+    context->hiz_width = (context->zbuffer.width + HIZ_WIDTH - 1) / HIZ_WIDTH;
+    context->hiz_height = (context->zbuffer.height + HIZ_HEIGHT - 1) / HIZ_HEIGHT;
+    context->hiz_data = M3D_AllocMem(context->hiz_width * context->hiz_height * sizeof(M3D_HiZTile));
+    if (context->hiz_data == NULL) {
+      Dbug(kprintf("[MAGGIE3D] No memory for the hierarchical Z buffer\n");)
+    }
+    M3D_ClearHiZ(context);
+    // The new Z buffer is fully cleared by the next M3D_ClearZBuffer
+    if (context->dirty_data != NULL) {
+      M3D_MarkDirtyTiles(context, ((M3D_DirtyMap *) context->dirty_data)->ztiles, 0, 0, context->zbuffer.width - 1, context->zbuffer.height - 1);
+    }
     Dbug(kprintf("[MAGGIE3D] Z buffer allocated (%ld x %ld) at 0x%lx \n", context->zbuffer.width, context->zbuffer.height, context->zbuffer.data);)
     return M3D_SUCCESS;
   }
@@ -45,14 +62,67 @@ VOID __asm __saveds LIBM3D_FreeZBuffer(register __a0 M3D_Context *context)
     context->zbuffer.bpr = 0;
     context->zbuffer.bpp = 0;
     context->zbuffer.data = NULL;
+    if (context->hiz_data != NULL) {
+      M3D_FreeMem(context->hiz_data);
+    }
+    context->hiz_data = NULL;
     Dbug(kprintf("[MAGGIE3D] Z buffer released\n");)
   }
 }
 
-/** Clear the Z buffer */
+/** Set the Z mapping of the depth band used by the current frame */
+VOID M3D_SetZBand(M3D_Context *context)
+{
+  // The first frame uses the highest band, the next ones are always in front of the previous ones
+  context->z_scale = 1.0 / context->zbuffer_frames;
+  context->z_offset = (context->zbuffer_frames - 1 - context->zbuffer_frame) * (ZBUF_RANGE / context->zbuffer_frames);
+  DDbug(kprintf("[MAGGIE3D] Z buffer band %ld of %ld\n", context->zbuffer_frame, context->zbuffer_frames);)
+}
+
+/** Set the number of frames sharing one Z buffer clear */
+LONG __asm __saveds LIBM3D_SetZBufferFrames(register __a0 M3D_Context *context, register __d0 UWORD frames)
+{
+  if (context == NULL) {
+    return M3D_NOCONTEXT;
+  }
+  if (frames < 1 || frames > M3D_MAXZFRAMES) {
+    return M3D_BADPARAM;
+  }
+  // Binned figures use the previous Z mapping
+  M3D_FlushBins(context);
+  context->zbuffer_frames = frames;
+  // Force a full clear on the next M3D_ClearZBuffer
+  context->zbuffer_frame = frames - 1;
+  M3D_SetZBand(context);
+  return M3D_SUCCESS;
+}
+
+/** Clear the Z buffer, or switch to the next depth band if the frames share the clear */
 LONG __asm __saveds LIBM3D_ClearZBuffer(register __a0 M3D_Context *context)
 {
+  M3D_Scissor rect;
+
   if (context != NULL && context->zbuffer.data != NULL) {
+    M3D_FlushBins(context);
+    M3D_FlushSpans();
+    if (context->zbuffer_frame + 1 < context->zbuffer_frames) {
+      // Z values of the previous frames are all behind the next band, the coarse Z tiles stay valid
+      context->zbuffer_frame++;
+      M3D_SetZBand(context);
+      return M3D_SUCCESS;
+    }
+    context->zbuffer_frame = 0;
+    M3D_SetZBand(context);
+    M3D_ClearHiZ(context);
+    if (context->dirty_data != NULL) {
+      // A white 16 bits clear writes the Z clear value
+      rect.left = 0;
+      rect.top = 0;
+      rect.width = context->zbuffer.width;
+      rect.height = context->zbuffer.height;
+      M3D_ClearDirtyTiles(context, ((M3D_DirtyMap *) context->dirty_data)->ztiles, context->zbuffer.data, context->zbuffer.bpr, ZBUF_BPP, 16, &rect, 0xffffff);
+      return M3D_SUCCESS;
+    }
     return M3D_FastClearZBuffer((ULONG) context->zbuffer.data, (UWORD) context->zbuffer.height, (UWORD) context->zbuffer.bpr);
   }
   return M3D_NOCONTEXT;
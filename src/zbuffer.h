@@ -14,6 +14,8 @@
 #define ZBUF_BPP                    2
 #define ZBUF_ALIGN                  8
 #define ZBUF_CLEARVAL               0xffff
+// Z values are converted to signed 16:16 fixed point by the span functions
+#define ZBUF_RANGE                  32768.0
 
 /** External function for Z buffer clear */
 extern BOOL __asm M3D_FastClearZBuffer(